@@ -0,0 +1,215 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include "eventpipeline.h"
+
+#include "hashing.h"
+#include "providerstats.h"
+
+#include <utils/algorithm.h>
+#include <utils/environment.h>
+
+#include <QCborArray>
+#include <QCborMap>
+#include <QInsightTracker>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QLoggingCategory>
+
+Q_DECLARE_LOGGING_CATEGORY(statLog)
+
+using namespace std::chrono;
+using namespace Utils;
+
+namespace UsageStatistic::Internal {
+
+void addEvent(QInsightTracker *tracker, const QString &key, const QString &data)
+{
+#if QT_VERSION >= QTVERSION_WITH_CONTEXTDATA
+    tracker->contextData(key, data);
+#else
+    tracker->interaction(key, data, 0);
+#endif
+}
+
+static QJsonValue toJson(const EventRecord::Value &value)
+{
+    if (const auto string = std::get_if<QString>(&value))
+        return *string;
+    if (const auto boolean = std::get_if<bool>(&value))
+        return *boolean;
+    if (const auto number = std::get_if<qint64>(&value))
+        return *number;
+    if (const auto list = std::get_if<QStringList>(&value))
+        return QJsonArray::fromStringList(*list);
+    if (const auto map = std::get_if<QVariantMap>(&value))
+        return QJsonObject::fromVariantMap(*map);
+    if (const auto hashedValue = std::get_if<EventRecord::Hashed>(&value))
+        return hashed(hashedValue->value);
+    const auto &hashedList = std::get<EventRecord::HashedList>(value);
+    return QJsonArray::fromStringList(Utils::transform(hashedList.values, hashed));
+}
+
+// Prefix of CBOR encoded payloads, which also tells the backend the version of the format.
+const char kCborPrefix[] = "cbor1:";
+
+static QCborValue toCbor(const EventRecord::Value &value)
+{
+    if (const auto string = std::get_if<QString>(&value))
+        return *string;
+    if (const auto boolean = std::get_if<bool>(&value))
+        return *boolean;
+    if (const auto number = std::get_if<qint64>(&value))
+        return *number;
+    if (const auto list = std::get_if<QStringList>(&value))
+        return QCborArray::fromStringList(*list);
+    if (const auto map = std::get_if<QVariantMap>(&value))
+        return QCborMap::fromVariantMap(*map);
+    // raw digests are half the size of the hex encoded ones
+    if (const auto hashedValue = std::get_if<EventRecord::Hashed>(&value))
+        return hashedRaw(hashedValue->value);
+    const auto &hashedList = std::get<EventRecord::HashedList>(value);
+    QCborArray digests;
+    for (const QString &entry : hashedList.values)
+        digests.append(hashedRaw(entry));
+    return digests;
+}
+
+static QString serializeCbor(const EventRecord &record)
+{
+    QCborMap map;
+    for (const auto &[key, value] : record.fields)
+        map.insert(key, toCbor(value));
+    const QCborValue cbor = map.toCborValue();
+    if (record.log)
+        qCDebug(record.log) << qPrintable(cbor.toDiagnosticNotation());
+    // context data is text, base64 is supported by every consumer
+    return QString::fromLatin1(kCborPrefix) + QString::fromLatin1(cbor.toCbor().toBase64());
+}
+
+static QString serializeJson(const EventRecord &record)
+{
+    QJsonObject json;
+    for (const auto &[key, value] : record.fields)
+        json.insert(key, toJson(value));
+    const QString jsonStr = QString::fromUtf8(QJsonDocument(json).toJson(QJsonDocument::Compact));
+    if (record.log)
+        qCDebug(record.log) << qPrintable(jsonStr);
+    return jsonStr;
+}
+
+EventPipeline::EventPipeline(QInsightTracker *tracker)
+    : m_tracker(tracker)
+    , m_encoding(
+          qtcEnvironmentVariable("QTC_USAGESTATISTIC_PAYLOAD_ENCODING") == "cbor" ? Encoding::Cbor
+                                                                                 : Encoding::Json)
+    , m_dryRun(qtcEnvironmentVariableIntValue("QTC_USAGESTATISTIC_DRY_RUN") == 1)
+{
+    // a single thread keeps the order of the events
+    m_worker.setMaxThreadCount(1);
+}
+
+EventPipeline::~EventPipeline()
+{
+    m_worker.waitForDone();
+    // the queued delivery of the last batch is dropped with this object, so deliver it here,
+    // followed by the records that were pushed after it
+    deliverSerialized();
+    deliver(serializeAll());
+}
+
+void EventPipeline::push(EventRecord &&record)
+{
+    auto node = new Node{std::move(record), Clock::now()};
+    node->next = m_head.load(std::memory_order_relaxed);
+    while (!m_head.compare_exchange_weak(
+        node->next, node, std::memory_order_release, std::memory_order_relaxed)) {
+    }
+    // only the first record after the queue was emptied needs to wake up the worker,
+    // the others are picked up by the same run
+    if (node->next)
+        return;
+    m_worker.start([this] {
+        Batch batch = serializeAll();
+        if (batch.isEmpty())
+            return;
+        {
+            QMutexLocker locker(&m_serializedMutex);
+            m_serialized.append(std::move(batch));
+        }
+        QMetaObject::invokeMethod(this, [this] { deliverSerialized(); }, Qt::QueuedConnection);
+    });
+}
+
+void EventPipeline::deliverSerialized()
+{
+    Batch batch;
+    {
+        QMutexLocker locker(&m_serializedMutex);
+        batch = std::exchange(m_serialized, {});
+    }
+    if (!batch.isEmpty())
+        deliver(batch);
+}
+
+EventPipeline::Node *EventPipeline::takeAll()
+{
+    // the records are linked from newest to oldest, reverse them
+    Node *node = m_head.exchange(nullptr, std::memory_order_acquire);
+    Node *reversed = nullptr;
+    while (node) {
+        Node *next = node->next;
+        node->next = reversed;
+        reversed = node;
+        node = next;
+    }
+    return reversed;
+}
+
+EventPipeline::Batch EventPipeline::serializeAll()
+{
+    const Clock::time_point start = Clock::now();
+    Batch batch;
+    Node *node = takeAll();
+    while (node) {
+        batch.append(
+            {node->record.key,
+             m_encoding == Encoding::Cbor ? serializeCbor(node->record)
+                                          : serializeJson(node->record),
+             node->pushed,
+             std::move(node->record.onDelivered)});
+        // the keys of the records are the names of the providers
+        ProviderStats &stats = providerStats(node->record.key);
+        ++stats.events;
+        stats.payloadBytes += batch.last().data.toUtf8().size();
+        delete std::exchange(node, node->next);
+    }
+    if (!batch.isEmpty()) {
+        qCDebug(statLog) << "Serialized" << batch.size() << "events in"
+                         << duration_cast<microseconds>(Clock::now() - start).count() << "us";
+    }
+    return batch;
+}
+
+void EventPipeline::deliver(const Batch &batch)
+{
+    if (!m_tracker)
+        return;
+    const Clock::time_point start = Clock::now();
+    for (const Event &event : batch) {
+        if (m_dryRun) {
+            qCDebug(statLog) << "Dry run event" << event.key << "-" << event.data.toUtf8().size()
+                             << "bytes, latency"
+                             << duration_cast<microseconds>(start - event.pushed).count() << "us";
+        } else if (m_tracker->isEnabled()) {
+            addEvent(m_tracker, event.key, event.data);
+            if (event.onDelivered)
+                event.onDelivered();
+        }
+    }
+    qCDebug(statLog) << "Delivered" << batch.size() << "events in"
+                     << duration_cast<microseconds>(Clock::now() - start).count() << "us";
+}
+
+} // namespace UsageStatistic::Internal
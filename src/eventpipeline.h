@@ -0,0 +1,98 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#pragma once
+
+#include <QMutex>
+#include <QObject>
+#include <QPointer>
+#include <QStringList>
+#include <QThreadPool>
+#include <QVariantMap>
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <variant>
+
+QT_BEGIN_NAMESPACE
+class QInsightTracker;
+class QLoggingCategory;
+QT_END_NAMESPACE
+
+namespace UsageStatistic::Internal {
+
+#define QTVERSION_WITH_CONTEXTDATA QT_VERSION_CHECK(6, 9, 2)
+
+void addEvent(QInsightTracker *tracker, const QString &key, const QString &data);
+
+//! Typed data of a context data event. Converting it to the payload that is sent,
+//! including the hashing of values, is done by the EventPipeline.
+struct EventRecord
+{
+    struct Hashed
+    {
+        QString value;
+    };
+    struct HashedList
+    {
+        QStringList values;
+    };
+    // Maps are sent as objects, for values with several parts, like the summary of a histogram.
+    using Value = std::variant<QString, bool, qint64, QStringList, QVariantMap, Hashed, HashedList>;
+
+    QString key;
+    QList<std::pair<QString, Value>> fields;
+    const QLoggingCategory &(*log)() = nullptr;
+    // Called on the GUI thread once the event was added to an enabled tracker.
+    std::function<void()> onDelivered;
+};
+
+//! Serializes event records on a worker thread and adds them to the tracker in batches.
+//! Adding a record is a lock-free push, so it can be done from any thread.
+//! Payloads are compact JSON, or with QTC_USAGESTATISTIC_PAYLOAD_ENCODING=cbor base64
+//! encoded CBOR with raw digests, prefixed with "cbor1:".
+//! With QTC_USAGESTATISTIC_DRY_RUN=1 the events are only logged with their size and latency,
+//! which allows measuring the cost of the providers without sending anything.
+//! In that case, or when the tracker is disabled, the events are not considered delivered.
+class EventPipeline : public QObject
+{
+public:
+    explicit EventPipeline(QInsightTracker *tracker);
+    ~EventPipeline() override;
+
+    void push(EventRecord &&record);
+
+private:
+    using Clock = std::chrono::steady_clock;
+    struct Node
+    {
+        EventRecord record;
+        Clock::time_point pushed;
+        Node *next = nullptr;
+    };
+    struct Event
+    {
+        QString key;
+        QString data;
+        Clock::time_point pushed;
+        std::function<void()> onDelivered;
+    };
+    using Batch = QList<Event>;
+    enum class Encoding { Json, Cbor };
+
+    Node *takeAll();
+    Batch serializeAll();
+    void deliverSerialized();
+    void deliver(const Batch &batch);
+
+    QPointer<QInsightTracker> m_tracker;
+    const Encoding m_encoding;
+    const bool m_dryRun;
+    std::atomic<Node *> m_head = nullptr; // most recently pushed record
+    QMutex m_serializedMutex;
+    Batch m_serialized; // serialized by the worker, but not yet delivered
+    QThreadPool m_worker;
+};
+
+} // namespace UsageStatistic::Internal
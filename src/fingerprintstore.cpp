@@ -0,0 +1,85 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include "fingerprintstore.h"
+
+#include <QCryptographicHash>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QLoggingCategory>
+
+Q_DECLARE_LOGGING_CATEGORY(statLog)
+
+using namespace Utils;
+
+namespace UsageStatistic::Internal {
+
+FingerprintStore::FingerprintStore(const FilePath &file)
+    : m_file(file)
+{
+    // several updates usually happen in a row, e.g. when a session is loaded
+    m_saveTimer.setSingleShot(true);
+    m_saveTimer.setInterval(5000);
+    connect(&m_saveTimer, &QTimer::timeout, this, &FingerprintStore::save);
+    load();
+}
+
+FingerprintStore::~FingerprintStore()
+{
+    if (m_saveTimer.isActive())
+        save();
+}
+
+QByteArray FingerprintStore::fingerprint(const QStringList &values)
+{
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    for (const QString &value : values) {
+        hash.addData(value.toUtf8());
+        hash.addData(QByteArrayView("\0", 1));
+    }
+    return hash.result();
+}
+
+bool FingerprintStore::contains(const QString &key, const QByteArray &fingerprint) const
+{
+    return m_fingerprints.value(key) == fingerprint;
+}
+
+bool FingerprintStore::update(const QString &key, const QByteArray &fingerprint)
+{
+    QByteArray &stored = m_fingerprints[key];
+    if (stored == fingerprint)
+        return false;
+    stored = fingerprint;
+    m_saveTimer.start();
+    return true;
+}
+
+void FingerprintStore::load()
+{
+    const Result<QByteArray> contents = m_file.fileContents();
+    if (!contents)
+        return;
+    const QJsonObject json = QJsonDocument::fromJson(*contents).object();
+    for (auto it = json.constBegin(); it != json.constEnd(); ++it)
+        m_fingerprints.insert(it.key(), QByteArray::fromHex(it.value().toString().toLatin1()));
+}
+
+void FingerprintStore::save()
+{
+    m_saveTimer.stop();
+    QJsonObject json;
+    for (auto it = m_fingerprints.constBegin(); it != m_fingerprints.constEnd(); ++it)
+        json.insert(it.key(), QString::fromLatin1(it.value().toHex()));
+    if (Result<> created = m_file.parentDir().ensureWritableDir(); !created) {
+        qCDebug(statLog) << "Failed to save fingerprints:" << created.error();
+        return;
+    }
+    if (Result<qint64> written = m_file.writeFileContents(
+            QJsonDocument(json).toJson(QJsonDocument::Compact));
+        !written) {
+        qCDebug(statLog) << "Failed to save fingerprints:" << written.error();
+    }
+}
+
+} // namespace UsageStatistic::Internal
@@ -0,0 +1,39 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#pragma once
+
+#include <utils/filepath.h>
+
+#include <QHash>
+#include <QObject>
+#include <QTimer>
+
+namespace UsageStatistic::Internal {
+
+//! Remembers a fingerprint of the last data that was reported for a key, in memory
+//! and in a file that survives sessions, so unchanged data does not need to be reported again.
+class FingerprintStore : public QObject
+{
+public:
+    explicit FingerprintStore(const Utils::FilePath &file);
+    ~FingerprintStore() override;
+
+    static QByteArray fingerprint(const QStringList &values);
+
+    // Whether the fingerprint is the one stored for the key.
+    bool contains(const QString &key, const QByteArray &fingerprint) const;
+    // Stores the fingerprint for the key and returns whether it differs from the previous one.
+    // Only call this once the data was actually reported.
+    bool update(const QString &key, const QByteArray &fingerprint);
+
+private:
+    void load();
+    void save();
+
+    Utils::FilePath m_file;
+    QHash<QString, QByteArray> m_fingerprints;
+    QTimer m_saveTimer;
+};
+
+} // namespace UsageStatistic::Internal
@@ -0,0 +1,83 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include "hashing.h"
+
+#include <projectexplorer/project.h>
+
+#include <QCryptographicHash>
+#include <QHash>
+#include <QMutex>
+
+using namespace ProjectExplorer;
+using namespace Utils;
+
+namespace UsageStatistic::Internal {
+
+// Enough for the module names of several Qt versions and the open projects.
+// The cache is simply dropped when it is full, the values are cheap to recompute.
+const qsizetype kMaxCachedDigests = 4096;
+
+static QMutex &digestMutex()
+{
+    static QMutex mutex;
+    return mutex;
+}
+
+static QHash<QString, QString> &digestCache()
+{
+    static QHash<QString, QString> cache;
+    return cache;
+}
+
+QString hashed(const QString &value)
+{
+    {
+        QMutexLocker locker(&digestMutex());
+        const auto it = digestCache().constFind(value);
+        if (it != digestCache().constEnd())
+            return *it;
+    }
+    const QString digest = QString::fromLatin1(
+        QCryptographicHash::hash(value.toUtf8(), QCryptographicHash::Sha1).toHex());
+    QMutexLocker locker(&digestMutex());
+    if (digestCache().size() >= kMaxCachedDigests)
+        digestCache().clear();
+    digestCache().insert(value, digest);
+    return digest;
+}
+
+QByteArray hashedRaw(const QString &value)
+{
+    return QByteArray::fromHex(hashed(value).toLatin1());
+}
+
+QString projectId(Project *project)
+{
+    return hashed(project->projectFilePath().toFSPathString());
+}
+
+void precomputeModuleDigests(const FilePaths &qmlPaths)
+{
+    for (const FilePath &qmlPath : qmlPaths) {
+        if (!qmlPath.isLocal())
+            continue;
+        const FilePaths qmldirs = qmlPath.dirEntries(
+            FileFilter({"qmldir"}, QDir::Files, QDirIterator::Subdirectories));
+        for (const FilePath &qmldir : qmldirs) {
+            const Result<QByteArray> contents = qmldir.fileContents();
+            if (!contents)
+                continue;
+            const QList<QByteArray> lines = contents->split('\n');
+            for (const QByteArray &line : lines) {
+                const QList<QByteArray> tokens = line.simplified().split(' ');
+                if (tokens.size() >= 2 && tokens.first() == "module") {
+                    hashed(QString::fromUtf8(tokens.at(1)));
+                    break;
+                }
+            }
+        }
+    }
+}
+
+} // namespace UsageStatistic::Internal
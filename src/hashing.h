@@ -0,0 +1,29 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#pragma once
+
+#include <utils/filepath.h>
+
+#include <QString>
+
+namespace ProjectExplorer {
+class Project;
+}
+
+namespace UsageStatistic::Internal {
+
+//! Pseudonymizes a value with a hex encoded SHA1 digest.
+//! The backend maps digests of known values (e.g. Qt module names) back to the values.
+//! Digests are cached, the function can be called from any thread.
+QString hashed(const QString &value);
+//! The digest of hashed() as 20 raw bytes, for binary payloads.
+QByteArray hashedRaw(const QString &value);
+
+QString projectId(ProjectExplorer::Project *project);
+
+//! Fills the digest cache with the names of the QML modules found in the given directories.
+//! Blocks while the directories are searched, do not call on the GUI thread.
+void precomputeModuleDigests(const Utils::FilePaths &qmlPaths);
+
+} // namespace UsageStatistic::Internal
@@ -0,0 +1,34 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include "insightstorage.h"
+
+using namespace Utils;
+
+namespace UsageStatistic::Internal {
+
+InsightStorage::InsightStorage(const FilePath &directory)
+    : m_directory(directory)
+{}
+
+qint64 InsightStorage::usage() const
+{
+    qint64 size = 0;
+    for (const FilePath &file : files())
+        size += file.fileSize();
+    return size;
+}
+
+Result<> InsightStorage::purge() const
+{
+    if (!m_directory.exists())
+        return ResultOk;
+    return m_directory.removeRecursively();
+}
+
+FilePaths InsightStorage::files() const
+{
+    return m_directory.dirEntries(FileFilter({}, QDir::Files, QDirIterator::Subdirectories));
+}
+
+} // namespace UsageStatistic::Internal
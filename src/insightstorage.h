@@ -0,0 +1,27 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#pragma once
+
+#include <utils/filepath.h>
+#include <utils/result.h>
+
+namespace UsageStatistic::Internal {
+
+//! Manages the directory in which QInsightTracker stores data until it is sent.
+//! Must not be used to modify the directory while a tracker is using it.
+class InsightStorage
+{
+public:
+    explicit InsightStorage(const Utils::FilePath &directory);
+
+    qint64 usage() const;
+    Utils::Result<> purge() const;
+
+private:
+    Utils::FilePaths files() const;
+
+    Utils::FilePath m_directory;
+};
+
+} // namespace UsageStatistic::Internal
@@ -0,0 +1,81 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include "loglinearhistogram.h"
+
+#include <QtAlgorithms>
+
+#include <algorithm>
+#include <cmath>
+
+namespace UsageStatistic::Internal {
+
+int LogLinearHistogram::bucketIndex(qint64 value)
+{
+    if (value < kSubBuckets)
+        return int(std::max<qint64>(value, 0));
+    const int range = 63 - qCountLeadingZeroBits(quint64(value)); // >= kSubBucketBits
+    const int shift = range - kSubBucketBits;
+    const int subBucket = int(value >> shift) - kSubBuckets;
+    return std::min((shift + 1) * kSubBuckets + subBucket, kBuckets - 1);
+}
+
+qint64 LogLinearHistogram::bucketUpperBound(int index)
+{
+    if (index < kSubBuckets)
+        return index;
+    const int shift = index / kSubBuckets - 1;
+    const qint64 lowerBound = qint64(kSubBuckets + index % kSubBuckets) << shift;
+    return lowerBound + (qint64(1) << shift) - 1;
+}
+
+void LogLinearHistogram::add(qint64 value)
+{
+    ++m_buckets[bucketIndex(value)];
+    ++m_count;
+    m_max = std::max(m_max, value);
+}
+
+void LogLinearHistogram::clear()
+{
+    m_buckets.fill(0);
+    m_count = 0;
+    m_max = 0;
+}
+
+qint64 LogLinearHistogram::percentile(double percent) const
+{
+    if (m_count == 0)
+        return 0;
+    const qint64 rank = std::max<qint64>(1, qint64(std::ceil(percent / 100 * m_count)));
+    qint64 seen = 0;
+    for (int i = 0; i < kBuckets; ++i) {
+        seen += m_buckets[i];
+        if (seen >= rank)
+            return std::min(bucketUpperBound(i), m_max);
+    }
+    return m_max;
+}
+
+QVariantMap LogLinearHistogram::buckets() const
+{
+    QVariantMap buckets;
+    for (int i = 0; i < kBuckets; ++i) {
+        if (m_buckets[i] != 0)
+            buckets.insert(QString::number(i), qint64(m_buckets[i]));
+    }
+    return buckets;
+}
+
+QVariantMap LogLinearHistogram::summary() const
+{
+    return {
+        {"count", m_count},
+        {"p50", percentile(50)},
+        {"p90", percentile(90)},
+        {"p99", percentile(99)},
+        {"max", m_max},
+        {"buckets", buckets()}};
+}
+
+} // namespace UsageStatistic::Internal
@@ -0,0 +1,45 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#pragma once
+
+#include <QVariantMap>
+
+#include <array>
+
+namespace UsageStatistic::Internal {
+
+//! Histogram of non-negative values with a fixed memory footprint.
+//! Every power of two range is split into kSubBuckets linear buckets, so the relative error
+//! of a percentile is below 1 / kSubBuckets. Values above the last bucket are clamped.
+class LogLinearHistogram
+{
+public:
+    static constexpr int kSubBucketBits = 2;
+    static constexpr int kSubBuckets = 1 << kSubBucketBits;
+    static constexpr int kRanges = 32; // values up to 2^32, e.g. milliseconds for 49 days
+    static constexpr int kBuckets = kRanges * kSubBuckets;
+
+    void add(qint64 value);
+    void clear();
+
+    bool isEmpty() const { return m_count == 0; }
+    qint64 count() const { return m_count; }
+    qint64 max() const { return m_max; }
+    // Upper bound of the bucket that contains the given percentile, from 0 to 100.
+    qint64 percentile(double percent) const;
+    // Counts of the non-empty buckets by index, so histograms can be merged by the backend.
+    QVariantMap buckets() const;
+    // Object with "count", "p50", "p90", "p99", "max" and the "buckets".
+    QVariantMap summary() const;
+
+    static int bucketIndex(qint64 value);
+    static qint64 bucketUpperBound(int index);
+
+private:
+    std::array<quint32, kBuckets> m_buckets{};
+    qint64 m_count = 0;
+    qint64 m_max = 0;
+};
+
+} // namespace UsageStatistic::Internal
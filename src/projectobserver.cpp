@@ -0,0 +1,203 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include "projectobserver.h"
+
+#include "hashing.h"
+
+#include <projectexplorer/buildsystem.h>
+#include <projectexplorer/devicesupport/devicekitaspects.h>
+#include <projectexplorer/kitmanager.h>
+#include <projectexplorer/project.h>
+#include <projectexplorer/projectexplorerconstants.h>
+#include <projectexplorer/projectmanager.h>
+#include <projectexplorer/toolchain.h>
+#include <projectexplorer/toolchainkitaspect.h>
+#include <projectexplorer/toolchainmanager.h>
+
+#include <debugger/debuggeritem.h>
+#include <debugger/debuggerkitaspect.h>
+
+#include <qtsupport/baseqtversion.h>
+#include <qtsupport/qtkitaspect.h>
+#include <qtsupport/qtversionmanager.h>
+
+// BUILD TIME DEPENDENCIES ONLY:
+#include <android/androidconstants.h>
+#include <baremetal/baremetalconstants.h>
+#include <boot2qt/qdbconstants.h>
+#include <devcontainer/devcontainerplugin_constants.h>
+#include <docker/dockerconstants.h>
+#include <ios/iosconstants.h>
+#include <mcusupport/mcusupportconstants.h>
+#include <remote/remotelinux_constants.h>
+#include <webassembly/webassemblyconstants.h>
+#include <qnx/qnxconstants.h>
+
+using namespace Debugger;
+using namespace ProjectExplorer;
+using namespace QtSupport;
+using namespace Utils;
+
+namespace UsageStatistic::Internal {
+
+struct IdName
+{
+    const char *id;
+    const char *name;
+};
+
+// Names that are reported for the toolchain types. Unknown types are reported with their id.
+const IdName kToolchainTypes[] = {
+    {Android::Constants::ANDROID_TOOLCHAIN_TYPEID, "android"},
+    {BareMetal::Constants::IAREW_TOOLCHAIN_TYPEID, "iarew"},
+    {BareMetal::Constants::KEIL_TOOLCHAIN_TYPEID, "keil"},
+    {BareMetal::Constants::SDCC_TOOLCHAIN_TYPEID, "sdcc"},
+    {ProjectExplorer::Constants::CUSTOM_TOOLCHAIN_TYPEID, "custom"},
+    {ProjectExplorer::Constants::GCC_TOOLCHAIN_TYPEID, "gcc"},
+    {ProjectExplorer::Constants::CLANG_TOOLCHAIN_TYPEID, "clang"},
+    {ProjectExplorer::Constants::MINGW_TOOLCHAIN_TYPEID, "mingw"},
+    {ProjectExplorer::Constants::LINUXICC_TOOLCHAIN_TYPEID, "icc"},
+    {ProjectExplorer::Constants::MSVC_TOOLCHAIN_TYPEID, "msvc"},
+    {ProjectExplorer::Constants::CLANG_CL_TOOLCHAIN_TYPEID, "clangcl"},
+    {Qnx::Constants::QNX_TOOLCHAIN_ID, "qnx"},
+    {WebAssembly::Constants::WEBASSEMBLY_TOOLCHAIN_TYPEID, "webassembly"},
+    {"VxWorks.ToolChain.Id", "vxworks"},
+};
+
+// Names that are reported for the device types. Unknown types are reported with their id.
+const IdName kDeviceTypes[] = {
+    {ProjectExplorer::Constants::DESKTOP_DEVICE_TYPE, "desktop"},
+    {Android::Constants::ANDROID_DEVICE_TYPE, "android"},
+    {BareMetal::Constants::BareMetalOsType, "baremetal"},
+    {ProjectExplorer::Constants::BOOT2QT_DEVICE_TYPE, "boot2qt"},
+    {DevContainer::Constants::DEVCONTAINER_DEVICE_TYPE, "devcontainer"},
+    {Docker::Constants::DOCKER_DEVICE_TYPE, "docker"},
+    {Ios::Constants::IOS_DEVICE_TYPE, "ios"},
+    {Ios::Constants::IOS_SIMULATOR_TYPE, "iossimulator"},
+    {McuSupport::Internal::Constants::DEVICE_TYPE, "mcu"},
+    {Qnx::Constants::QNX_QNX_OS_TYPE, "qnx"},
+    {Remote::Constants::GenericLinuxOsType, "remotelinux"},
+    {WebAssembly::Constants::WEBASSEMBLY_DEVICE_TYPE, "webassembly"},
+    {"VxWorks.Device.Type", "vxworks"},
+};
+
+// Ids are registered at runtime, so the tables are turned into hashes on first use.
+// Names of unknown ids are added when they are looked up, so every id is converted only once.
+template<size_t N>
+static QString lookupName(QHash<Id, QString> &names, const IdName (&table)[N], const Id &id)
+{
+    if (names.isEmpty()) {
+        names.reserve(N);
+        for (const IdName &entry : table)
+            names.insert(Id(entry.id), QString::fromLatin1(entry.name));
+    }
+    auto it = names.constFind(id);
+    if (it == names.cend())
+        it = names.insert(id, id.toString());
+    return *it;
+}
+
+static QString cppCompilerType(Toolchain *tc)
+{
+    if (!tc)
+        return "None";
+    static QHash<Id, QString> names;
+    return lookupName(names, kToolchainTypes, tc->typeId());
+}
+
+ProjectObserver::ProjectObserver()
+{
+    connect(KitManager::instance(), &KitManager::kitUpdated, this, [this](Kit *kit) {
+        m_kitSnapshots.remove(kit);
+    });
+    connect(KitManager::instance(), &KitManager::kitRemoved, this, [this](Kit *kit) {
+        m_kitSnapshots.remove(kit);
+    });
+    connect(ToolchainManager::instance(), &ToolchainManager::toolchainsChanged, this, [this] {
+        m_kitSnapshots.clear();
+    });
+    connect(QtVersionManager::instance(), &QtVersionManager::qtVersionsChanged, this, [this] {
+        m_kitSnapshots.clear();
+    });
+
+    connect(
+        ProjectManager::instance(),
+        &ProjectManager::projectAdded,
+        this,
+        &ProjectObserver::watchProject);
+    // the observer is created after startup, when a session might already be loaded
+    for (Project *project : ProjectManager::projects())
+        watchProject(project);
+    connect(
+        ProjectManager::instance(),
+        &ProjectManager::projectRemoved,
+        this,
+        [this](Project *project) {
+            m_projectIds.remove(project);
+        });
+}
+
+void ProjectObserver::watchProject(Project *project)
+{
+    connect(project, &Project::anyParsingStarted, this, [this, project] {
+        emit projectParsingStarted(project);
+    });
+    connect(project, &Project::anyParsingFinished, this, [this, project] {
+        emit projectParsed(createSnapshot(project));
+    });
+}
+
+std::shared_ptr<const KitSnapshot> ProjectObserver::kitSnapshot(Kit *kit)
+{
+    if (!kit)
+        return {};
+    std::shared_ptr<const KitSnapshot> &cached = m_kitSnapshots[kit];
+    if (cached)
+        return cached;
+
+    auto snapshot = std::make_shared<KitSnapshot>();
+    snapshot->qtVersion = QtKitAspect::qtVersion(kit);
+    snapshot->qtVersionString = snapshot->qtVersion
+                                    ? snapshot->qtVersion->qtVersion().toString()
+                                    : QString("None");
+    snapshot->buildDeviceType = nicerDeviceType(BuildDeviceTypeKitAspect::deviceTypeId(kit));
+    snapshot->runDeviceType = nicerDeviceType(RunDeviceTypeKitAspect::deviceTypeId(kit));
+    Toolchain *tc = ToolchainKitAspect::toolchain(kit, ProjectExplorer::Constants::CXX_LANGUAGE_ID);
+    snapshot->cppCompilerType = cppCompilerType(tc);
+    snapshot->cppCompilerVersion = tc ? tc->version().toString() : QString("None");
+    const DebuggerItem debugger = DebuggerKitAspect::debugger(kit);
+    snapshot->debuggerType = debugger.isValid() ? debugger.engineTypeName() : QString("None");
+    snapshot->debuggerVersion = debugger.isValid() ? debugger.version() : QString("None");
+    cached = snapshot;
+    return cached;
+}
+
+QString ProjectObserver::projectId(Project *project)
+{
+    QString &id = m_projectIds[project];
+    if (id.isEmpty())
+        id = Internal::projectId(project);
+    return id;
+}
+
+QString ProjectObserver::nicerDeviceType(const Id &id)
+{
+    static QHash<Id, QString> names;
+    return lookupName(names, kDeviceTypes, id);
+}
+
+ProjectSnapshot ProjectObserver::createSnapshot(Project *project)
+{
+    ProjectSnapshot snapshot;
+    snapshot.project = project;
+    snapshot.projectId = projectId(project);
+    snapshot.projectFilePath = project->projectFilePath();
+    if (BuildSystem *buildSystem = project->activeBuildSystem()) {
+        snapshot.buildSystemName = buildSystem->name();
+        snapshot.kit = kitSnapshot(buildSystem->kit());
+    }
+    return snapshot;
+}
+
+} // namespace UsageStatistic::Internal
@@ -0,0 +1,73 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#pragma once
+
+#include <utils/filepath.h>
+
+#include <QHash>
+#include <QObject>
+
+#include <memory>
+
+namespace ProjectExplorer {
+class Kit;
+class Project;
+} // namespace ProjectExplorer
+
+namespace QtSupport {
+class QtVersion;
+}
+
+namespace UsageStatistic::Internal {
+
+//! The kit related information that providers report, already converted to strings.
+struct KitSnapshot
+{
+    QtSupport::QtVersion *qtVersion = nullptr;
+    QString qtVersionString;
+    QString buildDeviceType;
+    QString runDeviceType;
+    QString cppCompilerType;
+    QString cppCompilerVersion;
+    QString debuggerType;
+    QString debuggerVersion;
+};
+
+//! State of a project after it was parsed.
+struct ProjectSnapshot
+{
+    ProjectExplorer::Project *project = nullptr;
+    QString projectId;
+    Utils::FilePath projectFilePath;
+    QString buildSystemName;
+    std::shared_ptr<const KitSnapshot> kit; // null if there is no active build system or kit
+};
+
+//! Watches the parsing of all projects and provides one snapshot per parse to the providers.
+//! Kit snapshots are cached until the kit, its toolchains or the Qt versions change.
+class ProjectObserver : public QObject
+{
+    Q_OBJECT
+
+public:
+    ProjectObserver();
+
+    std::shared_ptr<const KitSnapshot> kitSnapshot(ProjectExplorer::Kit *kit);
+    QString projectId(ProjectExplorer::Project *project);
+
+    static QString nicerDeviceType(const Utils::Id &id);
+
+signals:
+    void projectParsingStarted(ProjectExplorer::Project *project);
+    void projectParsed(const UsageStatistic::Internal::ProjectSnapshot &snapshot);
+
+private:
+    void watchProject(ProjectExplorer::Project *project);
+    ProjectSnapshot createSnapshot(ProjectExplorer::Project *project);
+
+    QHash<ProjectExplorer::Kit *, std::shared_ptr<const KitSnapshot>> m_kitSnapshots;
+    QHash<ProjectExplorer::Project *, QString> m_projectIds;
+};
+
+} // namespace UsageStatistic::Internal
@@ -0,0 +1,64 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include "providerstats.h"
+
+#include <QLocale>
+#include <QLoggingCategory>
+#include <QMutex>
+#include <QStringList>
+
+#include <map>
+#include <memory>
+
+Q_DECLARE_LOGGING_CATEGORY(statLog)
+
+namespace UsageStatistic::Internal {
+
+static QMutex s_mutex;
+static std::map<QString, std::unique_ptr<ProviderStats>> s_stats; // sorted for the report
+
+ProviderStats &providerStats(const QString &provider)
+{
+    QMutexLocker locker(&s_mutex);
+    std::unique_ptr<ProviderStats> &stats = s_stats[provider];
+    if (!stats)
+        stats = std::make_unique<ProviderStats>();
+    return *stats;
+}
+
+static QString milliseconds(qint64 nsecs)
+{
+    return QString::number(double(nsecs) / 1000000, 'f', 1) + " ms";
+}
+
+QStringList providerStatsReport()
+{
+    QMutexLocker locker(&s_mutex);
+    QStringList report;
+    for (const auto &[provider, stats] : s_stats) {
+        QString line = QString("%1: %2 events, %3, %4 in handlers")
+                           .arg(provider)
+                           .arg(stats->events.load())
+                           .arg(QLocale::c().formattedDataSize(stats->payloadBytes.load()))
+                           .arg(milliseconds(stats->handlerNsecs.load()));
+        if (stats->scansStarted.load() > 0) {
+            line += QString(", %1 scans (%2 cached, %3 failed), %4 scanning")
+                        .arg(stats->scansStarted.load())
+                        .arg(stats->scansSkipped.load())
+                        .arg(stats->scansFailed.load())
+                        .arg(milliseconds(stats->scanNsecs.load()));
+        }
+        report.append(line);
+    }
+    return report;
+}
+
+void logProviderStats()
+{
+    const QStringList report = providerStatsReport();
+    for (const QString &line : report)
+        qCDebug(statLog) << qPrintable(line);
+}
+
+} // namespace UsageStatistic::Internal
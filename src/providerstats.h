@@ -0,0 +1,49 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#pragma once
+
+#include <QElapsedTimer>
+#include <QStringList>
+
+#include <atomic>
+
+namespace UsageStatistic::Internal {
+
+//! Counters for the work done by a provider. They can be updated from any thread.
+struct ProviderStats
+{
+    std::atomic<qint64> events = 0;
+    std::atomic<qint64> payloadBytes = 0;
+    std::atomic<qint64> handlerNsecs = 0;
+    std::atomic<qint64> scansStarted = 0;
+    std::atomic<qint64> scansSkipped = 0; // resolved from the cache
+    std::atomic<qint64> scansFailed = 0;
+    std::atomic<qint64> scanNsecs = 0;
+};
+
+//! Returns the counters of the provider with the given name, creating them on first use.
+//! The counters live as long as the plugin, they are not reset when the tracker is recreated.
+ProviderStats &providerStats(const QString &provider);
+
+//! One line per provider, sorted by name.
+QStringList providerStatsReport();
+void logProviderStats();
+
+//! Adds the time until its destruction to the handler time of a provider.
+class HandlerTimer
+{
+public:
+    explicit HandlerTimer(ProviderStats &stats)
+        : m_stats(stats)
+    {
+        m_timer.start();
+    }
+    ~HandlerTimer() { m_stats.handlerNsecs += m_timer.nsecsElapsed(); }
+
+private:
+    ProviderStats &m_stats;
+    QElapsedTimer m_timer;
+};
+
+} // namespace UsageStatistic::Internal
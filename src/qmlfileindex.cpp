@@ -0,0 +1,90 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include "qmlfileindex.h"
+
+#include <projectexplorer/project.h>
+#include <projectexplorer/projectmanager.h>
+#include <projectexplorer/projectnodes.h>
+
+#include <utils/mimeconstants.h>
+#include <utils/mimeutils.h>
+
+using namespace ProjectExplorer;
+using namespace Utils;
+
+namespace UsageStatistic::Internal {
+
+QmlFileIndex::QmlFileIndex()
+{
+    const auto trackProject = [this](Project *project) {
+        connect(project, &Project::fileListChanged, this, [this, project] {
+            m_dirty.insert(project);
+        });
+        m_dirty.insert(project);
+    };
+    connect(ProjectManager::instance(), &ProjectManager::projectAdded, this, trackProject);
+    connect(
+        ProjectManager::instance(),
+        &ProjectManager::projectRemoved,
+        this,
+        [this](Project *project) {
+            m_qmlFiles.remove(project);
+            m_sourceFileCounts.remove(project);
+            m_dirty.remove(project);
+        });
+    for (Project *project : ProjectManager::projects())
+        trackProject(project);
+}
+
+FilePaths QmlFileIndex::qmlFiles(Project *project)
+{
+    updateIfDirty(project);
+    return m_qmlFiles.value(project);
+}
+
+int QmlFileIndex::sourceFileCount(Project *project)
+{
+    updateIfDirty(project);
+    return m_sourceFileCounts.value(project);
+}
+
+void QmlFileIndex::updateIfDirty(Project *project)
+{
+    if (!m_dirty.remove(project) && m_qmlFiles.contains(project))
+        return;
+    // the project tree must not be accessed from other threads, so this runs on the GUI thread;
+    // the source files are counted in the same walk, the nodes are sorted by file path
+    int sourceFileCount = 0;
+    FilePath lastSourceFile;
+    m_qmlFiles.insert(project, project->files([&](const Node *n) {
+        if (Project::SourceFiles(n) && n->filePath() != lastSourceFile) {
+            lastSourceFile = n->filePath();
+            ++sourceFileCount;
+        }
+        return isQmlFile(n);
+    }));
+    m_sourceFileCounts.insert(project, sourceFileCount);
+}
+
+bool QmlFileIndex::isQmlFile(const Node *node)
+{
+    const FilePath filePath = node->filePath();
+    if (!node->asFileNode() || node->isGenerated() || !node->isEnabled() || filePath.isEmpty())
+        return false;
+    // QML files are identified by their extension only, so the result can be shared
+    // between all files with the same suffix
+    const QString suffix = filePath.suffix();
+    if (suffix.isEmpty())
+        return false;
+    const auto it = m_isQmlSuffix.constFind(suffix);
+    if (it != m_isQmlSuffix.constEnd())
+        return *it;
+    const MimeType mimeType = mimeTypeForFile(filePath, MimeMatchMode::MatchExtension);
+    const bool isQml = mimeType.matchesName(Utils::Constants::QML_MIMETYPE)
+                       || mimeType.matchesName(Utils::Constants::QMLUI_MIMETYPE);
+    m_isQmlSuffix.insert(suffix, isQml);
+    return isQml;
+}
+
+} // namespace UsageStatistic::Internal
@@ -0,0 +1,44 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#pragma once
+
+#include <utils/filepath.h>
+
+#include <QHash>
+#include <QObject>
+#include <QSet>
+
+namespace ProjectExplorer {
+class Node;
+class Project;
+} // namespace ProjectExplorer
+
+namespace UsageStatistic::Internal {
+
+//! Keeps the list of QML files and the number of source files for each open project.
+//! Project::fileListChanged does not tell what changed, so a change only marks the project as
+//! dirty. The project tree is walked on the GUI thread when the data of a dirty project is asked
+//! for, so projects that are never asked for, like C++ only projects, are never walked.
+//! Classifying the files is cheap, because it is memoized per file suffix.
+//! The index is shared by the providers, so the tree is walked only once per change.
+class QmlFileIndex : public QObject
+{
+    Q_OBJECT
+public:
+    QmlFileIndex();
+
+    Utils::FilePaths qmlFiles(ProjectExplorer::Project *project);
+    int sourceFileCount(ProjectExplorer::Project *project);
+
+private:
+    void updateIfDirty(ProjectExplorer::Project *project);
+    bool isQmlFile(const ProjectExplorer::Node *node);
+
+    QHash<ProjectExplorer::Project *, Utils::FilePaths> m_qmlFiles;
+    QHash<ProjectExplorer::Project *, int> m_sourceFileCounts;
+    QSet<ProjectExplorer::Project *> m_dirty;
+    QHash<QString, bool> m_isQmlSuffix;
+};
+
+} // namespace UsageStatistic::Internal
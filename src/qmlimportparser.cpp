@@ -0,0 +1,238 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include "qmlimportparser.h"
+
+#include <utils/algorithm.h>
+
+#include <QSet>
+#include <QtConcurrent/QtConcurrentMap>
+
+using namespace Utils;
+
+namespace UsageStatistic::Internal {
+
+namespace {
+
+class ImportLexer
+{
+public:
+    explicit ImportLexer(QStringView source)
+        : m_source(source)
+    {}
+
+    Result<QStringList> moduleImports()
+    {
+        QStringList modules;
+        while (true) {
+            if (Result<> skipped = skipWhitespaceAndComments(); !skipped)
+                return ResultError(skipped.error());
+            const QStringView word = identifier();
+            if (word == u"pragma") {
+                if (Result<> skipped = skipStatement(); !skipped)
+                    return ResultError(skipped.error());
+            } else if (word == u"import") {
+                if (Result<> skipped = skipSpaces(); !skipped)
+                    return ResultError(skipped.error());
+                if (atEnd())
+                    return ResultError("Unexpected end of file in import statement");
+                if (current() == '"' || current() == '\'') {
+                    // directory or JavaScript import, not a module
+                    if (Result<> skipped = skipString(); !skipped)
+                        return ResultError(skipped.error());
+                } else {
+                    const QStringView uri = identifier();
+                    if (uri.isEmpty())
+                        return ResultError(
+                            QString("Unexpected character in import statement at %1").arg(m_pos));
+                    modules.append(uri.toString());
+                }
+                if (Result<> skipped = skipStatement(); !skipped)
+                    return ResultError(skipped.error());
+            } else {
+                // start of the object tree
+                return modules;
+            }
+        }
+    }
+
+private:
+    bool atEnd() const { return m_pos >= m_source.size(); }
+    QChar current() const { return m_source.at(m_pos); }
+    QChar next() const { return m_pos + 1 < m_source.size() ? m_source.at(m_pos + 1) : QChar(); }
+
+    static bool isIdentifierChar(QChar c) { return c.isLetterOrNumber() || c == '_' || c == '.'; }
+
+    QStringView identifier()
+    {
+        const qsizetype start = m_pos;
+        while (!atEnd() && isIdentifierChar(current()))
+            ++m_pos;
+        return m_source.sliced(start, m_pos - start);
+    }
+
+    // Skips a comment if there is one at the current position.
+    Result<> skipComment(bool *skipped)
+    {
+        *skipped = false;
+        if (current() != '/')
+            return ResultOk;
+        if (next() == '/') {
+            while (!atEnd() && current() != '\n')
+                ++m_pos;
+            *skipped = true;
+        } else if (next() == '*') {
+            const qsizetype end = m_source.indexOf(u"*/", m_pos + 2);
+            if (end < 0)
+                return ResultError("Unterminated comment");
+            m_pos = end + 2;
+            *skipped = true;
+        }
+        return ResultOk;
+    }
+
+    Result<> skipWhitespaceAndComments()
+    {
+        while (!atEnd()) {
+            if (current().isSpace() || current() == QChar::ByteOrderMark) {
+                ++m_pos;
+                continue;
+            }
+            bool skipped = false;
+            if (Result<> result = skipComment(&skipped); !result)
+                return result;
+            if (!skipped)
+                break;
+        }
+        return ResultOk;
+    }
+
+    // Skips whitespace and comments on the current line.
+    Result<> skipSpaces()
+    {
+        while (!atEnd() && current() != '\n') {
+            if (current().isSpace()) {
+                ++m_pos;
+                continue;
+            }
+            bool skipped = false;
+            if (Result<> result = skipComment(&skipped); !result)
+                return result;
+            if (!skipped)
+                break;
+        }
+        return ResultOk;
+    }
+
+    Result<> skipString()
+    {
+        const QChar quote = current();
+        for (++m_pos; !atEnd(); ++m_pos) {
+            if (current() == '\n')
+                break;
+            if (current() == '\\') {
+                ++m_pos;
+                continue;
+            }
+            if (current() == quote) {
+                ++m_pos;
+                return ResultOk;
+            }
+        }
+        return ResultError("Unterminated string");
+    }
+
+    // Skips the rest of a statement (version, qualifier, ...), which ends at a newline or ';'.
+    Result<> skipStatement()
+    {
+        while (!atEnd()) {
+            const QChar c = current();
+            if (c == '\n' || c == ';') {
+                ++m_pos;
+                break;
+            }
+            if (c == '"' || c == '\'') {
+                if (Result<> skipped = skipString(); !skipped)
+                    return skipped;
+                continue;
+            }
+            bool skipped = false;
+            if (Result<> result = skipComment(&skipped); !result)
+                return result;
+            if (!skipped)
+                ++m_pos;
+        }
+        return ResultOk;
+    }
+
+    QStringView m_source;
+    qsizetype m_pos = 0;
+};
+
+} // namespace
+
+Result<QStringList> parseQmlModuleImports(QStringView source)
+{
+    return ImportLexer(source).moduleImports();
+}
+
+static Result<QStringList> parseQmlFile(const FilePath &file)
+{
+    const Result<QByteArray> contents = file.fileContents();
+    if (!contents)
+        return ResultError(contents.error());
+    const Result<QStringList> imports = parseQmlModuleImports(QString::fromUtf8(*contents));
+    if (!imports)
+        return ResultError(QString("%1: %2").arg(file.toUserOutput(), imports.error()));
+    return imports;
+}
+
+// Returns the modules that the qmldir file of the given module declares as dependencies.
+static QStringList qmldirDependencies(const QString &uri, const FilePaths &importPaths)
+{
+    const QString relativePath = QString(uri).replace('.', '/') + "/qmldir";
+    for (const FilePath &importPath : importPaths) {
+        const Result<QByteArray> contents = importPath.pathAppended(relativePath).fileContents();
+        if (!contents)
+            continue;
+        QStringList dependencies;
+        const QList<QByteArray> lines = contents->split('\n');
+        for (const QByteArray &line : lines) {
+            const QList<QByteArray> tokens = line.simplified().split(' ');
+            if (tokens.size() >= 2 && (tokens.first() == "import" || tokens.first() == "depends"))
+                dependencies.append(QString::fromUtf8(tokens.at(1)));
+        }
+        return dependencies;
+    }
+    return {};
+}
+
+Result<QStringList> scanQmlModuleImports(const FilePaths &qmlFiles, const FilePaths &importPaths)
+{
+    if (!Utils::allOf(qmlFiles, &FilePath::isLocal))
+        return ResultError("Only local files are supported");
+
+    // projects can list files that were removed in the meantime, qmlimportscanner skips them too
+    const FilePaths existingFiles = Utils::filtered(qmlFiles, &FilePath::exists);
+    const QList<Result<QStringList>> results = QtConcurrent::blockingMapped(
+        existingFiles, parseQmlFile);
+
+    QStringList pending;
+    for (const Result<QStringList> &result : results) {
+        if (!result)
+            return ResultError(result.error());
+        pending.append(*result);
+    }
+
+    const FilePaths localImportPaths = Utils::filtered(importPaths, &FilePath::isLocal);
+    QSet<QString> modules;
+    while (!pending.isEmpty()) {
+        const QString uri = pending.takeLast();
+        if (!Utils::insert(modules, uri))
+            continue;
+        pending.append(qmldirDependencies(uri, localImportPaths));
+    }
+    return Utils::sorted(Utils::toList(modules));
+}
+
+} // namespace UsageStatistic::Internal
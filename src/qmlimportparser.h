@@ -0,0 +1,28 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#pragma once
+
+#include <utils/filepath.h>
+#include <utils/result.h>
+
+#include <QStringList>
+
+namespace UsageStatistic::Internal {
+
+//! Returns the URIs of the modules that are imported in the header of a QML document.
+//! Only the import statements are lexed, parsing stops at the first object declaration.
+//! Fails for input that the lexer does not understand.
+Utils::Result<QStringList> parseQmlModuleImports(QStringView source);
+
+//! In-process replacement for the module part of qmlimportscanner.
+//! Lexes the files in parallel and adds the module dependencies that are declared
+//! in the qmldir files found in the import paths.
+//! Files that do not exist are skipped.
+//! Fails if any of the files cannot be handled, in which case the caller is expected
+//! to fall back to qmlimportscanner.
+//! Blocks until all files are processed, do not call on the GUI thread.
+Utils::Result<QStringList> scanQmlModuleImports(
+    const Utils::FilePaths &qmlFiles, const Utils::FilePaths &importPaths);
+
+} // namespace UsageStatistic::Internal
@@ -0,0 +1,125 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include "qmlmodulescache.h"
+
+#include <utils/algorithm.h>
+
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QSet>
+
+using namespace Utils;
+
+namespace UsageStatistic::Internal {
+
+// Upper bound for the number of scan results kept on disk.
+// Every entry is small, but projects and their file sets come and go.
+const int kMaxEntries = 256;
+
+QmlModulesCache::QmlModulesCache(const FilePath &directory)
+    : m_directory(directory)
+{}
+
+// Remote files are looked up with one directory listing per directory, instead of two round trips
+// to the device per file.
+QHash<FilePath, FilePathInfo> QmlModulesCache::fileInfos(const FilePaths &files)
+{
+    QHash<FilePath, FilePathInfo> infos;
+    QHash<FilePath, QSet<QString>> remoteFilesPerDirectory;
+    for (const FilePath &file : files) {
+        if (file.isLocal()) {
+            if (!file.exists())
+                continue;
+            FilePathInfo info;
+            info.fileSize = file.fileSize();
+            info.lastModified = file.lastModified();
+            infos.insert(file, info);
+        } else {
+            remoteFilesPerDirectory[file.parentDir()].insert(file.fileName());
+        }
+    }
+    for (auto it = remoteFilesPerDirectory.cbegin(); it != remoteFilesPerDirectory.cend(); ++it) {
+        const QSet<QString> &fileNames = it.value();
+        it.key().iterateDirectory(
+            [&infos, &fileNames](const FilePath &item, const FilePathInfo &info) {
+                if (fileNames.contains(item.fileName()))
+                    infos.insert(item, info);
+                return IterationPolicy::Continue;
+            },
+            {{}, QDir::Files});
+    }
+    return infos;
+}
+
+QString QmlModulesCache::fingerprint(
+    const QString &scanner,
+    const QString &qtVersion,
+    const FilePaths &importPaths,
+    const FilePaths &qmlFiles)
+{
+    return fingerprint(scanner, qtVersion, importPaths, qmlFiles, fileInfos(qmlFiles));
+}
+
+QString QmlModulesCache::fingerprint(
+    const QString &scanner,
+    const QString &qtVersion,
+    const FilePaths &importPaths,
+    const FilePaths &qmlFiles,
+    const QHash<FilePath, FilePathInfo> &infos)
+{
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    const auto add = [&hash](const QString &value) {
+        hash.addData(value.toUtf8());
+        hash.addData(QByteArrayView("\0", 1));
+    };
+    // the scanners do not necessarily find the same modules
+    add(scanner);
+    add(qtVersion);
+    for (const FilePath &importPath : importPaths)
+        add(importPath.toFSPathString());
+    add("--");
+    // the order of project files is not guaranteed to be stable
+    const FilePaths sortedFiles = Utils::sorted(FilePaths(qmlFiles));
+    for (const FilePath &file : sortedFiles) {
+        const FilePathInfo info = infos.value(file);
+        add(file.toFSPathString());
+        add(QString::number(info.fileSize));
+        add(QString::number(info.lastModified.toMSecsSinceEpoch()));
+    }
+    return QString::fromLatin1(hash.result().toHex());
+}
+
+std::optional<QStringList> QmlModulesCache::lookup(const QString &fingerprint) const
+{
+    const Result<QByteArray> contents = entryPath(fingerprint).fileContents();
+    if (!contents)
+        return {};
+    return QString::fromUtf8(*contents).split('\n', Qt::SkipEmptyParts);
+}
+
+Result<> QmlModulesCache::store(const QString &fingerprint, const QStringList &modules) const
+{
+    if (Result<> created = m_directory.ensureWritableDir(); !created)
+        return created;
+    const Result<qint64> written = entryPath(fingerprint).writeFileContents(
+        modules.join('\n').toUtf8());
+    if (!written)
+        return ResultError(written.error());
+    prune();
+    return ResultOk;
+}
+
+FilePath QmlModulesCache::entryPath(const QString &fingerprint) const
+{
+    return m_directory.pathAppended(fingerprint);
+}
+
+void QmlModulesCache::prune() const
+{
+    const FilePaths entries = m_directory.dirEntries({{}, QDir::Files}, QDir::Time);
+    for (int i = kMaxEntries; i < entries.size(); ++i)
+        entries.at(i).removeFile();
+}
+
+} // namespace UsageStatistic::Internal
@@ -0,0 +1,55 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#pragma once
+
+#include <utils/filepath.h>
+#include <utils/filepathinfo.h>
+#include <utils/result.h>
+
+#include <QHash>
+#include <QStringList>
+
+#include <optional>
+
+namespace UsageStatistic::Internal {
+
+//! Persistent, content-addressed store for the modules found by qmlimportscanner.
+//! Entries are keyed by a fingerprint of everything that influences the scan result,
+//! so an unchanged project can reuse the result of a previous scan.
+//! The class only holds the cache directory and can be copied to worker threads.
+class QmlModulesCache
+{
+public:
+    explicit QmlModulesCache(const Utils::FilePath &directory);
+
+    // Size and modification time of the files that exist. Remote files are looked up with
+    // one directory listing per directory. Accesses the file system, do not call on the GUI thread.
+    static QHash<Utils::FilePath, Utils::FilePathInfo> fileInfos(const Utils::FilePaths &files);
+
+    // The file infos are the result of fileInfos(), so callers can reuse them.
+    static QString fingerprint(
+        const QString &scanner,
+        const QString &qtVersion,
+        const Utils::FilePaths &importPaths,
+        const Utils::FilePaths &qmlFiles,
+        const QHash<Utils::FilePath, Utils::FilePathInfo> &infos);
+    // Looks up the file infos, do not call on the GUI thread.
+    static QString fingerprint(
+        const QString &scanner,
+        const QString &qtVersion,
+        const Utils::FilePaths &importPaths,
+        const Utils::FilePaths &qmlFiles);
+
+    std::optional<QStringList> lookup(const QString &fingerprint) const;
+    // Writes the entry and prunes old ones, do not call on the GUI thread.
+    Utils::Result<> store(const QString &fingerprint, const QStringList &modules) const;
+
+private:
+    Utils::FilePath entryPath(const QString &fingerprint) const;
+    void prune() const;
+
+    Utils::FilePath m_directory;
+};
+
+} // namespace UsageStatistic::Internal
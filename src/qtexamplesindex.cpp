@@ -0,0 +1,58 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include "qtexamplesindex.h"
+
+#include <qtsupport/baseqtversion.h>
+#include <qtsupport/qtversionmanager.h>
+
+using namespace QtSupport;
+using namespace Utils;
+
+namespace UsageStatistic::Internal {
+
+QtExamplesIndex::QtExamplesIndex()
+{
+    connect(QtVersionManager::instance(), &QtVersionManager::qtVersionsChanged, this, [this] {
+        m_dirty = true;
+    });
+}
+
+std::optional<QtExamplesIndex::Example> QtExamplesIndex::find(const FilePath &projectFilePath)
+{
+    if (m_dirty)
+        rebuild();
+    const auto cached = m_cache.constFind(projectFilePath);
+    if (cached != m_cache.constEnd())
+        return *cached;
+
+    std::optional<Example> example;
+    // the nearest examples directory among the parent directories
+    for (FilePath dir = projectFilePath.parentDir(); !dir.isEmpty(); dir = dir.parentDir()) {
+        const auto it = m_examplesPaths.constFind(dir);
+        if (it != m_examplesPaths.constEnd()) {
+            example = Example{*it, projectFilePath.relativeChildPath(dir).parentDir()};
+            break;
+        }
+        if (dir.isRootPath())
+            break;
+    }
+    m_cache.insert(projectFilePath, example);
+    return example;
+}
+
+void QtExamplesIndex::rebuild()
+{
+    m_dirty = false;
+    m_cache.clear();
+    m_examplesPaths.clear();
+    const QtVersions versions = QtVersionManager::versions();
+    for (QtVersion *qtVersion : versions) {
+        const FilePath examplesPath = qtVersion->examplesPath();
+        // the first Qt version wins if several share the examples
+        if (!examplesPath.isEmpty() && !m_examplesPaths.contains(examplesPath))
+            m_examplesPaths.insert(examplesPath, qtVersion->qtVersion().toString());
+    }
+}
+
+} // namespace UsageStatistic::Internal
@@ -0,0 +1,39 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#pragma once
+
+#include <utils/filepath.h>
+
+#include <QHash>
+#include <QObject>
+
+#include <optional>
+
+namespace UsageStatistic::Internal {
+
+//! Maps project files to the Qt version whose examples directory contains them.
+//! The table of examples directories is rebuilt only when the Qt versions change,
+//! and results are cached per project file.
+class QtExamplesIndex : public QObject
+{
+public:
+    struct Example
+    {
+        QString qtVersion;
+        Utils::FilePath examplePath; // relative to the examples directory
+    };
+
+    QtExamplesIndex();
+
+    std::optional<Example> find(const Utils::FilePath &projectFilePath);
+
+private:
+    void rebuild();
+
+    QHash<Utils::FilePath, QString> m_examplesPaths; // examples directory -> Qt version
+    QHash<Utils::FilePath, std::optional<Example>> m_cache;
+    bool m_dirty = true;
+};
+
+} // namespace UsageStatistic::Internal
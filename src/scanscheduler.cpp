@@ -0,0 +1,110 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include "scanscheduler.h"
+
+#include <projectexplorer/buildmanager.h>
+#include <projectexplorer/project.h>
+#include <projectexplorer/projectmanager.h>
+
+#include <utils/algorithm.h>
+#include <utils/environment.h>
+#include <utils/hostosinfo.h>
+#include <utils/qtcprocess.h>
+
+#include <QLoggingCategory>
+
+Q_DECLARE_LOGGING_CATEGORY(statLog)
+
+using namespace ProjectExplorer;
+using namespace Utils;
+
+namespace UsageStatistic::Internal {
+
+ScanScheduler::ScanScheduler()
+{
+    bool ok = false;
+    const int maxScans = qtcEnvironmentVariableIntValue(
+        "QTC_USAGESTATISTIC_MAX_CONCURRENT_SCANS", &ok);
+    if (ok && maxScans > 0)
+        m_maxConcurrentScans = maxScans;
+
+    connect(BuildManager::instance(), &BuildManager::buildQueueFinished, this, [this] {
+        startNext();
+    });
+    connect(
+        ProjectManager::instance(),
+        &ProjectManager::aboutToRemoveProject,
+        this,
+        [this](Project *project) {
+            Utils::eraseOne(m_queue, [project](const PendingScan &scan) {
+                return scan.project == project;
+            });
+            // the handlers of a running scan must not be called for a removed project,
+            // resetting the task tree does not call any of them
+            if (m_running.remove(project)) {
+                m_runner.resetKey(project);
+                startNext();
+            }
+        });
+}
+
+ScanScheduler::~ScanScheduler()
+{
+    // do not start queued scans while the running ones are canceled
+    m_queue.clear();
+}
+
+bool ScanScheduler::schedule(Project *project, const QtTaskTree::Group &recipe)
+{
+    if (isScheduled(project))
+        return false;
+    m_queue.append({project, recipe});
+    qCDebug(statLog) << "Queued scan for" << project->displayName() << "- queue depth:"
+                     << m_queue.size() << "running:" << m_running.size();
+    startNext();
+    return true;
+}
+
+bool ScanScheduler::isScheduled(Project *project) const
+{
+    return m_running.contains(project)
+           || Utils::anyOf(m_queue, [project](const PendingScan &scan) {
+                  return scan.project == project;
+              });
+}
+
+void ScanScheduler::setLowPriority(Process &process)
+{
+    process.setLowPriority();
+    if (!HostOsInfo::isLinuxHost() || !process.commandLine().executable().isLocal())
+        return;
+    static const FilePath ionice = Environment::systemEnvironment().searchInPath("ionice");
+    if (ionice.isEmpty())
+        return;
+    CommandLine command{ionice, {"-c", "3"}}; // idle IO scheduling class
+    command.addCommandLineAsArgs(process.commandLine());
+    process.setCommand(command);
+}
+
+void ScanScheduler::startNext()
+{
+    while (!m_queue.isEmpty() && m_running.size() < m_maxConcurrentScans) {
+        // wait until the build queue is done, the scans are not urgent
+        if (BuildManager::isBuilding())
+            return;
+        const PendingScan scan = m_queue.takeFirst();
+        m_running.insert(scan.project);
+        m_runner.start(
+            scan.project,
+            scan.recipe,
+            {},
+            [this, project = scan.project] {
+                m_running.remove(project);
+                startNext();
+            },
+            QtTaskTree::CallDone::OnSuccess | QtTaskTree::CallDone::OnError);
+    }
+}
+
+} // namespace UsageStatistic::Internal
@@ -0,0 +1,57 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#pragma once
+
+#include <QtTaskTree/QSingleTaskTreeRunner>
+
+#include <QList>
+#include <QObject>
+#include <QSet>
+
+namespace ProjectExplorer {
+class Project;
+}
+
+namespace Utils {
+class Process;
+}
+
+namespace UsageStatistic::Internal {
+
+//! Plugin wide queue for background scans of projects.
+//! Limits the number of concurrently running scans and holds back queued scans
+//! while builds are running, so the scans do not compete with the compiler.
+class ScanScheduler : public QObject
+{
+public:
+    ScanScheduler();
+    ~ScanScheduler() override;
+
+    // Returns false if a scan for the project is already queued or running.
+    bool schedule(ProjectExplorer::Project *project, const QtTaskTree::Group &recipe);
+    bool isScheduled(ProjectExplorer::Project *project) const;
+
+    int queueDepth() const { return m_queue.size(); }
+    int runningCount() const { return m_running.size(); }
+    int maxConcurrentScans() const { return m_maxConcurrentScans; }
+
+    // Lowers CPU and, where available, IO priority of a scanner process.
+    static void setLowPriority(Utils::Process &process);
+
+private:
+    struct PendingScan
+    {
+        ProjectExplorer::Project *project = nullptr;
+        QtTaskTree::Group recipe;
+    };
+
+    void startNext();
+
+    QList<PendingScan> m_queue;
+    QSet<ProjectExplorer::Project *> m_running;
+    int m_maxConcurrentScans = 1;
+    QtTaskTree::QMappedTaskTreeRunner<ProjectExplorer::Project *> m_runner;
+};
+
+} // namespace UsageStatistic::Internal
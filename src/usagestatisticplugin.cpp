@@ -3,6 +3,18 @@
 
 #include "usagestatisticplugin.h"
 #include "coreplugin/actionmanager/actionmanager.h"
+#include "eventpipeline.h"
+#include "fingerprintstore.h"
+#include "hashing.h"
+#include "insightstorage.h"
+#include "loglinearhistogram.h"
+#include "projectobserver.h"
+#include "providerstats.h"
+#include "qmlfileindex.h"
+#include "qmlimportparser.h"
+#include "qmlmodulescache.h"
+#include "qtexamplesindex.h"
+#include "scanscheduler.h"
 
 #include <extensionsystem/pluginmanager.h>
 #include <extensionsystem/pluginspec.h>
@@ -10,11 +22,11 @@
 #include <utils/appinfo.h>
 #include <utils/aspects.h>
 #include <utils/async.h>
+#include <utils/futuresynchronizer.h>
+#include <utils/filepathinfo.h>
 #include <utils/infobar.h>
 #include <utils/layoutbuilder.h>
 #include <utils/link.h>
-#include <utils/mimeconstants.h>
-#include <utils/mimeutils.h>
 #include <utils/qtcprocess.h>
 #include <utils/temporaryfile.h>
 #include <utils/theme/theme.h>
@@ -27,15 +39,8 @@
 
 #include <projectexplorer/buildmanager.h>
 #include <projectexplorer/buildsystem.h>
-#include <projectexplorer/devicesupport/devicekitaspects.h>
 #include <projectexplorer/project.h>
-#include <projectexplorer/projectexplorerconstants.h>
 #include <projectexplorer/projectmanager.h>
-#include <projectexplorer/toolchain.h>
-#include <projectexplorer/toolchainkitaspect.h>
-
-#include <debugger/debuggeritem.h>
-#include <debugger/debuggerkitaspect.h>
 
 #include <qtsupport/baseqtversion.h>
 #include <qtsupport/qtkitaspect.h>
@@ -46,29 +51,21 @@
 #include <QCryptographicHash>
 #include <QDialog>
 #include <QDialogButtonBox>
+#include <QElapsedTimer>
 #include <QGuiApplication>
 #include <QInsightConfiguration>
 #include <QInsightTracker>
 #include <QJsonArray>
 #include <QJsonDocument>
 #include <QJsonObject>
+#include <QLabel>
+#include <QMap>
 #include <QMetaEnum>
+#include <QPushButton>
+#include <QThread>
 #include <QTimer>
 
-// BUILD TIME DEPENDENCIES ONLY:
-#include <android/androidconstants.h>
-#include <baremetal/baremetalconstants.h>
-#include <boot2qt/qdbconstants.h>
-#include <devcontainer/devcontainerplugin_constants.h>
-#include <docker/dockerconstants.h>
-#include <ios/iosconstants.h>
-#include <mcusupport/mcusupportconstants.h>
-#include <remote/remotelinux_constants.h>
-#include <webassembly/webassemblyconstants.h>
-#include <qnx/qnxconstants.h>
-
 using namespace Core;
-using namespace Debugger;
 using namespace ExtensionSystem;
 using namespace ProjectExplorer;
 using namespace QtSupport;
@@ -81,51 +78,158 @@ Q_LOGGING_CATEGORY(qmlmodulesLog, "qtc.usagestatistic.qmlmodules", QtWarningMsg)
 Q_LOGGING_CATEGORY(projectWizardLog, "qtc.usagestatistic.projectwizard", QtWarningMsg);
 
 const char kSettingsPageId[] = "UsageStatistic.PreferencesPage";
+// fingerprints of the data that was reported, relative to the cache resource path
+const char kBuildConfigFingerprints[] = "usagestatistic/buildconfig.json";
+const char kQmlModulesFingerprints[] = "usagestatistic/qmlmodules.json";
 
 namespace UsageStatistic::Internal {
 
 static UsageStatisticPlugin *m_instance = nullptr;
 
-#define QTVERSION_WITH_CONTEXTDATA QT_VERSION_CHECK(6, 9, 2)
+static int fromEnvironment(const QString &key, int defaultValue)
+{
+    bool ok = false;
+    const int env = qtcEnvironmentVariableIntValue(key, &ok);
+    if (ok)
+        return env;
+    return defaultValue;
+}
 
-static void addEvent(QInsightTracker *tracker, const QString &key, const QString &data)
+#ifdef WITH_TESTS
+static QString fromEnvironment(const QString &key, const QString &defaultValue)
 {
-#if QT_VERSION >= QTVERSION_WITH_CONTEXTDATA
-    tracker->contextData(key, data);
-#else
-    tracker->interaction(key, data, 0);
+    const QString env = qtcEnvironmentVariable(key);
+    if (!env.isEmpty())
+        return env;
+    return defaultValue;
+}
 #endif
+
+static constexpr int defaultSubmissionInterval()
+{
+    using namespace std::literals;
+    return std::chrono::hours(1) / 1s;
 }
 
-static QString hashed(const QString &value)
+// Providers that aggregate data locally send their summaries as often as the tracker submits,
+// but not more often than once a minute. A repeating timer with an interval of 0 would fire on
+// every pass of the event loop.
+static std::chrono::seconds summaryInterval()
 {
-    return QString::fromLatin1(
-        QCryptographicHash::hash(value.toUtf8(), QCryptographicHash::Sha1).toHex());
+    return std::chrono::seconds(std::max(
+        60, fromEnvironment("QTC_INSIGHT_SUBMISSIONINTERVAL", defaultSubmissionInterval())));
 }
 
-static QString projectId(Project *project)
+static void addEvent(
+    ProviderStats &stats, QInsightTracker *tracker, const QString &key, const QString &data)
 {
-    return hashed(project->projectFilePath().toFSPathString());
+    ++stats.events;
+    stats.payloadBytes += data.toUtf8().size();
+    addEvent(tracker, key, data);
 }
 
+// By default, mode switches are debounced and only the time spent in each mode is sent
+// periodically. QTC_USAGESTATISTIC_RAW_MODE_CHANGES=1 sends every switch as a transition.
 class ModeChanges : public QObject
 {
     Q_OBJECT
 public:
-    ModeChanges(QInsightTracker *tracker)
+    ModeChanges(QInsightTracker *tracker, EventPipeline *events)
+        : m_tracker(tracker)
+        , m_events(events)
+        , m_raw(fromEnvironment("QTC_USAGESTATISTIC_RAW_MODE_CHANGES", 0) != 0)
     {
-        const auto id = [](const Id &modeId) -> QString {
-            QString ret = ":MODE:" + QString::fromUtf8(modeId.name());
-            if (modeId == Core::Constants::MODE_DESIGN)
-                ret += ":" + QString::fromUtf8(DesignMode::currentDesignWidget().name());
-            return ret;
-        };
-        connect(ModeManager::instance(), &ModeManager::currentModeChanged, this, [=](const Id &modeId) {
-            tracker->transition(id(modeId));
-        });
+        connect(
+            ModeManager::instance(),
+            &ModeManager::currentModeChanged,
+            this,
+            [this](const Id &modeId) {
+                const HandlerTimer timer(m_stats);
+                if (m_raw) {
+                    ++m_stats.events;
+                    m_tracker->transition(id(modeId));
+                    return;
+                }
+                // quickly toggling through modes only counts the last one
+                m_pendingMode = id(modeId);
+                m_debounceTimer.start();
+            });
         // initialize with current mode
-        tracker->transition(id(ModeManager::currentModeId()));
+        if (m_raw) {
+            m_tracker->transition(id(ModeManager::currentModeId()));
+            return;
+        }
+        m_currentMode = id(ModeManager::currentModeId());
+        m_inCurrentMode.start();
+
+        m_debounceTimer.setSingleShot(true);
+        m_debounceTimer.setInterval(
+            fromEnvironment("QTC_USAGESTATISTIC_MODE_DEBOUNCE_MS", defaultDebounceInterval));
+        connect(&m_debounceTimer, &QTimer::timeout, this, &ModeChanges::switchMode);
+
+        m_summaryTimer.setInterval(summaryInterval());
+        connect(&m_summaryTimer, &QTimer::timeout, this, &ModeChanges::reportSummary);
+        m_summaryTimer.start();
     }
+
+    ~ModeChanges() override
+    {
+        if (!m_raw) {
+            switchMode();
+            reportSummary();
+        }
+    }
+
+private:
+    static QString id(const Id &modeId)
+    {
+        QString ret = ":MODE:" + QString::fromUtf8(modeId.name());
+        if (modeId == Core::Constants::MODE_DESIGN)
+            ret += ":" + QString::fromUtf8(DesignMode::currentDesignWidget().name());
+        return ret;
+    }
+
+    void addDwellTime()
+    {
+        m_dwellTime[m_currentMode] += m_inCurrentMode.restart();
+    }
+
+    void switchMode()
+    {
+        if (m_pendingMode.isEmpty() || m_pendingMode == m_currentMode)
+            return;
+        addDwellTime();
+        m_currentMode = std::exchange(m_pendingMode, {});
+        ++m_switches;
+    }
+
+    void reportSummary()
+    {
+        addDwellTime();
+        EventRecord record{"ModeChanges", {{"switches", m_switches}}, statLog};
+        for (auto it = m_dwellTime.cbegin(); it != m_dwellTime.cend(); ++it) {
+            if (const qint64 seconds = it.value() / 1000)
+                record.fields.append({it.key(), seconds});
+        }
+        m_dwellTime.clear();
+        m_switches = 0;
+        if (record.fields.size() > 1)
+            m_events->push(std::move(record));
+    }
+
+    static constexpr int defaultDebounceInterval = 500; // ms
+
+    QInsightTracker *m_tracker = nullptr;
+    EventPipeline *m_events = nullptr;
+    const bool m_raw = false;
+    QString m_currentMode;
+    QString m_pendingMode;
+    QElapsedTimer m_inCurrentMode;
+    QMap<QString, qint64> m_dwellTime; // ms per mode
+    qint64 m_switches = 0;
+    QTimer m_debounceTimer;
+    QTimer m_summaryTimer;
+    ProviderStats &m_stats = providerStats("ModeChanges");
 };
 
 class UILanguage : public QObject
@@ -134,9 +238,12 @@ class UILanguage : public QObject
 public:
     UILanguage(QInsightTracker *tracker)
     {
-        addEvent(tracker, ":CONFIG:UILanguage", ICore::userInterfaceLanguage());
+        ProviderStats &stats = providerStats("UILanguage");
+        const HandlerTimer timer(stats);
+        addEvent(stats, tracker, ":CONFIG:UILanguage", ICore::userInterfaceLanguage());
         const QStringList languages = QLocale::system().uiLanguages();
-        addEvent(tracker,
+        addEvent(stats,
+                 tracker,
                  ":CONFIG:SystemLanguage",
                  languages.isEmpty() ? QString("Unknown") : languages.first());
     }
@@ -148,11 +255,17 @@ class Theme : public QObject
 public:
     Theme(QInsightTracker *tracker)
     {
-        addEvent(tracker, ":CONFIG:Theme", creatorTheme() ? creatorTheme()->id() : QString("Unknown"));
+        ProviderStats &stats = providerStats("Theme");
+        const HandlerTimer timer(stats);
+        addEvent(
+            stats,
+            tracker,
+            ":CONFIG:Theme",
+            creatorTheme() ? creatorTheme()->id() : QString("Unknown"));
         const QString systemTheme = QString::fromUtf8(QMetaEnum::fromType<Qt::ColorScheme>().valueToKey(
                                                           int(Utils::Theme::systemColorScheme())))
                                         .toLower();
-        addEvent(tracker, ":CONFIG:SystemTheme", systemTheme);
+        addEvent(stats, tracker, ":CONFIG:SystemTheme", systemTheme);
     }
 };
 
@@ -160,167 +273,106 @@ class BuildConfig : public QObject
 {
     Q_OBJECT
 public:
-    static QStringList getQtPackages(Project *project, QtVersion *qtVersion)
+    using ModuleHash = QHash<QString, Utils::Link>;
+
+    // Sorted Qt packages of the packages that CMake found. The result is cached per build system
+    // and Qt version until the found packages change.
+    QStringList getQtPackages(Project *project, QtVersion *qtVersion)
     {
         if (!qtVersion)
             return {};
+        BuildSystem *buildSystem = project->activeBuildSystem();
+        const ModuleHash all = buildSystem->additionalData("FoundPackages").value<ModuleHash>();
+        PackagesCacheEntry &entry = m_packagesCache[{buildSystem, qtVersion}];
+        // the Qt version object can be replaced by a different one at the same address
         const FilePath qtLibPath = qtVersion->libraryPath();
-        using ModuleHash = QHash<QString, Utils::Link>;
-        const ModuleHash all
-            = project->activeBuildSystem()->additionalData("FoundPackages").value<ModuleHash>();
+        if (entry.qtLibPath == qtLibPath && entry.foundPackages == all)
+            return entry.qtPackages;
+
+        // compare the paths as strings with a prefix that is computed once
+        const QString libPrefix = qtLibPath.cleanPath().path() + '/';
+        const Qt::CaseSensitivity caseSensitivity = qtLibPath.caseSensitivity();
         QStringList packages;
-        for (auto it = all.begin(); it != all.end(); ++it) {
-            const QString name = it.key();
-            const FilePath cmakePath = it.value().targetFilePath;
-            if (name.size() > 4 && name.startsWith("Qt") && name[2].isDigit() && name[3].isUpper()
-                && !name.endsWith("plugin", Qt::CaseInsensitive) && cmakePath.isChildOf(qtLibPath))
+        for (auto it = all.cbegin(); it != all.cend(); ++it) {
+            const QString &name = it.key();
+            if (name.size() <= 4 || !name.startsWith("Qt") || !name[2].isDigit()
+                || !name[3].isUpper() || name.endsWith("plugin", Qt::CaseInsensitive)) {
+                continue;
+            }
+            const FilePath &cmakePath = it.value().targetFilePath;
+            if (cmakePath.scheme() == qtLibPath.scheme() && cmakePath.host() == qtLibPath.host()
+                && cmakePath.path().startsWith(libPrefix, caseSensitivity)) {
                 packages.append(name);
+            }
         }
+        packages.sort();
+        entry = {qtLibPath, all, packages};
         return packages;
     }
 
-    static QString qtVersionString(QtVersion *qtVersion)
-    {
-        return qtVersion ? qtVersion->qtVersion().toString() : QString("None");
-    }
-
-    static QString nicerDeviceType(const Id &id)
-    {
-        if (id == ProjectExplorer::Constants::DESKTOP_DEVICE_TYPE)
-            return "desktop";
-        if (id == Android::Constants::ANDROID_DEVICE_TYPE)
-            return "android";
-        if (id == BareMetal::Constants::BareMetalOsType)
-            return "baremetal";
-        if (id == ProjectExplorer::Constants::BOOT2QT_DEVICE_TYPE)
-            return "boot2qt";
-        if (id == DevContainer::Constants::DEVCONTAINER_DEVICE_TYPE)
-            return "devcontainer";
-        if (id == Docker::Constants::DOCKER_DEVICE_TYPE)
-            return "docker";
-        if (id == Ios::Constants::IOS_DEVICE_TYPE)
-            return "ios";
-        if (id == Ios::Constants::IOS_SIMULATOR_TYPE)
-            return "iossimulator";
-        if (id == McuSupport::Internal::Constants::DEVICE_TYPE)
-            return "mcu";
-        if (id == Qnx::Constants::QNX_QNX_OS_TYPE)
-            return "qnx";
-        if (id == Remote::Constants::GenericLinuxOsType)
-            return "remotelinux";
-        if (id == WebAssembly::Constants::WEBASSEMBLY_DEVICE_TYPE)
-            return "webassembly";
-        if (id == "VxWorks.Device.Type")
-            return "vxworks";
-        return id.toString();
-    }
-
-    static QString buildDevice(Kit *kit)
-    {
-        return nicerDeviceType(BuildDeviceTypeKitAspect::deviceTypeId(kit));
-    }
-
-    static QString runDevice(Kit *kit)
-    {
-        return nicerDeviceType(RunDeviceTypeKitAspect::deviceTypeId(kit));
-    }
-
-    static QString cppCompiler(Kit *kit)
-    {
-        Toolchain *tc
-            = ToolchainKitAspect::toolchain(kit, ProjectExplorer::Constants::CXX_LANGUAGE_ID);
-        if (!tc)
-            return "None";
-        const Id type = tc->typeId();
-        if (type == Android::Constants::ANDROID_TOOLCHAIN_TYPEID)
-            return "android";
-        if (type == BareMetal::Constants::IAREW_TOOLCHAIN_TYPEID)
-            return "iarew";
-        if (type == BareMetal::Constants::KEIL_TOOLCHAIN_TYPEID)
-            return "keil";
-        if (type == BareMetal::Constants::SDCC_TOOLCHAIN_TYPEID)
-            return "sdcc";
-        if (type == ProjectExplorer::Constants::CUSTOM_TOOLCHAIN_TYPEID)
-            return "custom";
-        if (type == ProjectExplorer::Constants::GCC_TOOLCHAIN_TYPEID)
-            return "gcc";
-        if (type == ProjectExplorer::Constants::CLANG_TOOLCHAIN_TYPEID)
-            return "clang";
-        if (type == ProjectExplorer::Constants::MINGW_TOOLCHAIN_TYPEID)
-            return "mingw";
-        if (type == ProjectExplorer::Constants::LINUXICC_TOOLCHAIN_TYPEID)
-            return "icc";
-        if (type == ProjectExplorer::Constants::MSVC_TOOLCHAIN_TYPEID)
-            return "msvc";
-        if (type == ProjectExplorer::Constants::CLANG_CL_TOOLCHAIN_TYPEID)
-            return "clangcl";
-        if (type == Qnx::Constants::QNX_TOOLCHAIN_ID)
-            return "qnx";
-        if (type == WebAssembly::Constants::WEBASSEMBLY_TOOLCHAIN_TYPEID)
-            return "webassembly";
-        if (type == "VxWorks.ToolChain.Id")
-            return "vxworks";
-        return type.toString();
-    }
-
-    static QString cppCompilerVersion(Kit *kit)
-    {
-        Toolchain *tc
-            = ToolchainKitAspect::toolchain(kit, ProjectExplorer::Constants::CXX_LANGUAGE_ID);
-        if (!tc)
-            return "None";
-        return tc->version().toString();
-    }
-
-    static QString debugger(Kit *kit)
-    {
-        const DebuggerItem debugger = DebuggerKitAspect::debugger(kit);
-        if (!debugger.isValid())
-            return "None";
-        return debugger.engineTypeName();
-    }
-
-    static QString debuggerVersion(Kit *kit)
-    {
-        const DebuggerItem debugger = DebuggerKitAspect::debugger(kit);
-        if (!debugger.isValid())
-            return "None";
-        return debugger.version();
-    }
-
-    BuildConfig(QInsightTracker *tracker)
+    BuildConfig(EventPipeline *events, ProjectObserver *observer)
     {
+        // the cache is keyed by pointers, drop it when any of them might become invalid
+        connect(ProjectManager::instance(), &ProjectManager::projectRemoved, this, [this] {
+            m_packagesCache.clear();
+        });
+        connect(QtVersionManager::instance(), &QtVersionManager::qtVersionsChanged, this, [this] {
+            m_packagesCache.clear();
+        });
         connect(
-            ProjectManager::instance(),
-            &ProjectManager::projectAdded,
+            observer,
+            &ProjectObserver::projectParsed,
             this,
-            [this, tracker](Project *project) {
-                connect(project, &Project::anyParsingFinished, this, [project, tracker] {
-                    if (!project->activeBuildSystem())
-                        return;
-                    Kit *kit = project->activeBuildSystem()->kit();
-                    if (!kit)
-                        return;
-                    QtVersion *qtVersion = QtKitAspect::qtVersion(kit);
-                    const QStringList qtPackages = getQtPackages(project, qtVersion);
-                    QJsonObject json;
-                    json.insert("projectid", projectId(project));
-                    json.insert("qtmodules", QJsonArray::fromStringList(qtPackages));
-                    json.insert("qtversion", qtVersionString(qtVersion));
-                    json.insert("buildSystem", project->activeBuildSystem()->name());
-                    json.insert("buildDeviceType", buildDevice(kit));
-                    json.insert("runDeviceType", runDevice(kit));
-                    json.insert("cppCompilerType", cppCompiler(kit));
-                    json.insert("cppCompilerVersion", cppCompilerVersion(kit));
-                    json.insert("debuggerType", debugger(kit));
-                    json.insert("debuggerVersion", debuggerVersion(kit));
-                    const QString jsonStr = QString::fromUtf8(
-                        QJsonDocument(json).toJson(QJsonDocument::Compact));
-                    qCDebug(qtmodulesLog) << qPrintable(jsonStr);
-                    addEvent(tracker, "BuildConfig", jsonStr);
-                });
+            [this, events](const ProjectSnapshot &snapshot) {
+                const HandlerTimer timer(m_stats);
+                if (!snapshot.kit)
+                    return;
+                const KitSnapshot &kit = *snapshot.kit;
+                // sorted, so the fingerprint does not depend on the hash order
+                const QStringList qtPackages = getQtPackages(snapshot.project, kit.qtVersion);
+                const QList<std::pair<QString, QString>> fields = {
+                    {"qtversion", kit.qtVersionString},
+                    {"buildSystem", snapshot.buildSystemName},
+                    {"buildDeviceType", kit.buildDeviceType},
+                    {"runDeviceType", kit.runDeviceType},
+                    {"cppCompilerType", kit.cppCompilerType},
+                    {"cppCompilerVersion", kit.cppCompilerVersion},
+                    {"debuggerType", kit.debuggerType},
+                    {"debuggerVersion", kit.debuggerVersion}};
+                QStringList values = {qtPackages.join(',')};
+                for (const auto &[key, value] : fields)
+                    values << value;
+                const QByteArray fingerprint = FingerprintStore::fingerprint(values);
+                if (m_lastReported->contains(snapshot.projectId, fingerprint)) {
+                    qCDebug(qtmodulesLog)
+                        << "Build configuration unchanged for" << snapshot.projectId;
+                    return;
+                }
+                EventRecord record{"BuildConfig", {}, qtmodulesLog};
+                record.fields = {{"projectid", snapshot.projectId}, {"qtmodules", qtPackages}};
+                for (const auto &[key, value] : fields)
+                    record.fields.append({key, value});
+                // the store is shared, the event can be delivered after this provider is gone
+                record.onDelivered =
+                    [store = m_lastReported, key = snapshot.projectId, fingerprint] {
+                        store->update(key, fingerprint);
+                    };
+                events->push(std::move(record));
             });
     }
+
+private:
+    struct PackagesCacheEntry
+    {
+        FilePath qtLibPath;
+        ModuleHash foundPackages;
+        QStringList qtPackages;
+    };
+
+    std::shared_ptr<FingerprintStore> m_lastReported = std::make_shared<FingerprintStore>(
+        ICore::cacheResourcePath(kBuildConfigFingerprints));
+    QHash<std::pair<BuildSystem *, QtVersion *>, PackagesCacheEntry> m_packagesCache;
+    ProviderStats &m_stats = providerStats("BuildConfig");
 };
 
 class QmlModules : public QObject
@@ -328,9 +380,27 @@ class QmlModules : public QObject
     Q_OBJECT
 
 public:
-    using ScanStorage = QtTaskTree::Storage<std::unique_ptr<TemporaryFilePath>>;
-
-    QmlModules(QInsightTracker *tracker)
+    struct ScanData
+    {
+        QString fingerprint;
+        std::optional<QStringList> modules;
+        QSet<FilePath> existingFiles; // found while fingerprinting, for the response files
+        QSet<QString> scannedModules; // merged results of the qmlimportscanner shards
+        QElapsedTimer timer;
+    };
+    using ScanStorage = QtTaskTree::Storage<ScanData>;
+    using ShardStorage = QtTaskTree::Storage<FilePath>; // response file of the shard
+
+    struct CacheLookup
+    {
+        QString fingerprint;
+        std::optional<QStringList> modules;
+        QSet<FilePath> existingFiles;
+    };
+
+    QmlModules(EventPipeline *events, ScanScheduler *scheduler, QmlFileIndex *fileIndex)
+        : m_scheduler(scheduler)
+        , m_fileIndex(fileIndex)
     {
         // Management code for being able to access the project's import paths
         // Would be nice if this was available more directly from the project->activeBuildSystem()
@@ -346,12 +416,27 @@ public:
             &ProjectManager::buildConfigurationRemoved,
             this,
             [this](BuildConfiguration *bc) { m_qmlCodeModelInfo.remove(bc); });
+        connect(
+            ProjectManager::instance(),
+            &ProjectManager::projectRemoved,
+            this,
+            &QmlModules::removeResponseFiles);
+        // The module names of the Qt versions are the bulk of the hashed values
+        if (fromEnvironment("QTC_USAGESTATISTIC_PRECOMPUTE_DIGESTS", 0) != 0) {
+            connect(
+                QtVersionManager::instance(),
+                &QtVersionManager::qtVersionsChanged,
+                this,
+                &QmlModules::precomputeDigests);
+            precomputeDigests();
+        }
         // The actual retrieval of QML modules
         connect(
             BuildManager::instance(),
             &BuildManager::buildStateChanged,
             this,
-            [this, tracker](Project *project) {
+            [this, events](Project *project) {
+                const HandlerTimer timer(m_stats);
                 if (!shouldStartCollectingFor(project))
                     return;
 
@@ -370,16 +455,7 @@ public:
                     = m_qmlCodeModelInfo.value(project->activeBuildConfiguration()).qmlImportPaths;
                 if (!qtImportPath.isEmpty())
                     importPaths << qtImportPath;
-                const FilePaths qmlFiles = project->files([](const Node *n) -> bool {
-                    const FilePath filePath = n->filePath();
-                    if (!n->asFileNode() || n->isGenerated() || !n->isEnabled()
-                        || filePath.isEmpty())
-                        return false;
-                    const MimeType mimeType
-                        = mimeTypeForFile(filePath, MimeMatchMode::MatchExtension);
-                    return mimeType.matchesName(Utils::Constants::QML_MIMETYPE)
-                           || mimeType.matchesName(Utils::Constants::QMLUI_MIMETYPE);
-                });
+                const FilePaths qmlFiles = m_fileIndex->qmlFiles(project);
                 if (qmlFiles.isEmpty()) {
                     qCDebug(qmlmodulesLog) << QString("No QML files found for project \"%1\".")
                                                   .arg(project->displayName());
@@ -394,31 +470,223 @@ public:
                 const QString qtVersionString = qtVersion->qtVersion().toString();
 
                 const ScanStorage storage;
+                const auto skipIfResolved = [storage] {
+                    return storage->modules ? QtTaskTree::SetupResult::StopWithSuccess
+                                            : QtTaskTree::SetupResult::Continue;
+                };
+                const auto start = [storage] { storage->timer.start(); };
+                const auto report = [this, storage, id, qtVersionString, events](
+                                        QtTaskTree::DoneWith result) {
+                    m_stats.scanNsecs += storage->timer.nsecsElapsed();
+                    if (result == QtTaskTree::DoneWith::Error)
+                        ++m_stats.scansFailed;
+                    if (result != QtTaskTree::DoneWith::Success)
+                        return;
+                    if (storage->modules)
+                        reportModules(events, id, qtVersionString, *storage->modules);
+                };
 
-                m_runner.start(
+                const bool scheduled = m_scheduler->schedule(
                     project,
                     QtTaskTree::Group{
                         QtTaskTree::sequential,
                         storage,
-                        createResponseFile(storage, qmlimportscanner, qmlFiles, importPaths),
-                        runQmlImportScanner(storage, qmlimportscanner, id, qtVersionString, tracker)});
+                        QtTaskTree::onGroupSetup(start),
+                        lookupCache(storage, qtVersionString, qmlFiles, importPaths),
+                        QtTaskTree::Group{
+                            QtTaskTree::onGroupSetup(skipIfResolved),
+                            parseQmlImports(storage, qmlFiles, importPaths),
+                            runShardedQmlImportScanner(
+                                storage, project, qmlimportscanner, qmlFiles, importPaths)},
+                        QtTaskTree::onGroupDone(report)});
+                if (scheduled)
+                    ++m_stats.scansStarted;
             });
     }
 
+    ~QmlModules() override
+    {
+        const QList<Project *> projects = m_responseFiles.keys();
+        for (Project *project : projects)
+            removeResponseFiles(project);
+    }
+
+    QtTaskTree::ExecutableItem lookupCache(
+        const ScanStorage &storage,
+        const QString &qtVersionString,
+        const FilePaths &qmlFiles,
+        const FilePaths &importPaths)
+    {
+        const auto setup = [cache = m_cache, qtVersionString, qmlFiles, importPaths](
+                               Async<CacheLookup> &async) {
+            async.setConcurrentCallData(
+                [](const QmlModulesCache &cache,
+                   const QString &qtVersionString,
+                   const FilePaths &qmlFiles,
+                   const FilePaths &importPaths) -> CacheLookup {
+                    const QString scanner = useInternalScanner() ? QString("internal")
+                                                                 : QString("qmlimportscanner");
+                    // projects can list files that were removed in the meantime
+                    const QHash<FilePath, FilePathInfo> infos = QmlModulesCache::fileInfos(
+                        qmlFiles);
+                    const QString fingerprint = QmlModulesCache::fingerprint(
+                        scanner, qtVersionString, importPaths, qmlFiles, infos);
+                    QSet<FilePath> existingFiles;
+                    existingFiles.reserve(infos.size());
+                    for (auto it = infos.cbegin(); it != infos.cend(); ++it)
+                        existingFiles.insert(it.key());
+                    return {fingerprint, cache.lookup(fingerprint), existingFiles};
+                },
+                cache,
+                qtVersionString,
+                qmlFiles,
+                importPaths);
+        };
+        const auto done = [this, storage](const Async<CacheLookup> &async) {
+            const CacheLookup result = async.result();
+            if (result.modules) {
+                qCDebug(qmlmodulesLog) << "Using cached scan result" << result.fingerprint;
+                ++m_stats.scansSkipped;
+            }
+            storage->fingerprint = result.fingerprint;
+            storage->modules = result.modules;
+            storage->existingFiles = result.existingFiles;
+        };
+        return AsyncTask<CacheLookup>(setup, done, QtTaskTree::CallDone::OnSuccess);
+    }
+
+    // Optional in-process replacement for qmlimportscanner.
+    // If it fails, the modules stay unresolved and qmlimportscanner runs as a fallback.
+    QtTaskTree::ExecutableItem parseQmlImports(
+        const ScanStorage &storage, const FilePaths &qmlFiles, const FilePaths &importPaths)
+    {
+        const auto setup = [qmlFiles, importPaths](Async<Result<QStringList>> &async) {
+            if (!useInternalScanner())
+                return QtTaskTree::SetupResult::StopWithSuccess;
+            async.setConcurrentCallData(&scanQmlModuleImports, qmlFiles, importPaths);
+            return QtTaskTree::SetupResult::Continue;
+        };
+        const auto done = [this, storage](const Async<Result<QStringList>> &async) {
+            const Result<QStringList> result = async.result();
+            if (!result) {
+                qCDebug(qmlmodulesLog)
+                    << "Internal scanner failed, falling back to qmlimportscanner:"
+                    << result.error();
+                return;
+            }
+            setScanResult(storage, *result);
+        };
+        return AsyncTask<Result<QStringList>>(setup, done, QtTaskTree::CallDone::OnSuccess);
+    }
+
+    // Splits the files into shards that are scanned by concurrent qmlimportscanner processes.
+    QtTaskTree::ExecutableItem runShardedQmlImportScanner(
+        const ScanStorage &storage,
+        Project *project,
+        const FilePath &qmlimportscanner,
+        const FilePaths &qmlFiles,
+        const FilePaths &importPaths)
+    {
+        const int shardCount = scannerShardCount(qmlFiles.size());
+        const auto setup = [storage, shardCount, fileCount = qmlFiles.size()] {
+            if (storage->modules)
+                return QtTaskTree::SetupResult::StopWithSuccess;
+            qCDebug(qmlmodulesLog) << "Scanning" << fileCount << "files in" << shardCount
+                                   << "shards";
+            storage->scannedModules.clear();
+            return QtTaskTree::SetupResult::Continue;
+        };
+        const auto done = [this, storage] {
+            setScanResult(storage, Utils::sorted(Utils::toList(storage->scannedModules)));
+        };
+        QtTaskTree::GroupItems shards{
+            QtTaskTree::parallel,
+            QtTaskTree::onGroupSetup(setup),
+            QtTaskTree::onGroupDone(done, QtTaskTree::CallDone::OnSuccess)};
+        const qsizetype shardSize = (qmlFiles.size() + shardCount - 1) / shardCount;
+        for (qsizetype start = 0; start < qmlFiles.size(); start += shardSize) {
+            const ShardStorage responseFile;
+            shards << QtTaskTree::Group{
+                responseFile,
+                createResponseFile(
+                    storage,
+                    responseFile,
+                    project,
+                    int(start / shardSize),
+                    qmlimportscanner,
+                    qmlFiles.mid(start, shardSize),
+                    importPaths),
+                runQmlImportScanner(responseFile, storage, qmlimportscanner)};
+        }
+        return QtTaskTree::Group(shards);
+    }
+
+    static int scannerShardCount(qsizetype fileCount)
+    {
+        // starting a process per handful of files is not worth it
+        const int minFilesPerShard = 100;
+        static const int configured
+            = std::max(1, fromEnvironment("QTC_USAGESTATISTIC_QMLSCANNER_SHARDS", 4));
+        const int maxShards = std::min(configured, std::max(1, QThread::idealThreadCount()));
+        return int(std::clamp<qsizetype>(fileCount / minFilesPerShard, 1, maxShards));
+    }
+
+    // Assembles the response file in a single buffer instead of a list of lines that is joined,
+    // and writes it with one call, so a remote device is only contacted once.
+    static QByteArray responseFileContents(const FilePaths &qmlFiles, const FilePaths &importPaths)
+    {
+        QByteArray contents = "-qmlFiles";
+        for (const FilePath &file : qmlFiles)
+            contents.append('\n').append(file.nativePath().toUtf8());
+        for (const FilePath &importPath : importPaths)
+            contents.append("\n-importPath\n").append(importPath.nativePath().toUtf8());
+        return contents;
+    }
+
+    struct ResponseFile
+    {
+        std::shared_ptr<TemporaryFilePath> file; // removes the file with the last reference
+        QByteArray digest;
+        qint64 size = 0;
+    };
+
+    // The response files are created securely with a unique name, and kept per project and
+    // shard until the project is closed. They are only replaced if their contents change, which
+    // saves creating, writing and removing a file on the device for every scan. The unique name
+    // rules out planted files, so a file is reused if it still exists with the expected size,
+    // which is a single stat instead of reading the file back from the device.
     QtTaskTree::ExecutableItem createResponseFile(
         const ScanStorage &storage,
+        const ShardStorage &responseFile,
+        Project *project,
+        int shard,
         const FilePath &qmlimportscanner,
         const FilePaths &qmlFiles,
         const FilePaths &importPaths)
     {
-        const auto setup = [qmlimportscanner, qmlFiles, importPaths](
-                               Async<Result<TemporaryFilePath *>> &async) {
+        const auto setup = [this, storage, project, shard, qmlimportscanner, qmlFiles, importPaths](
+                               Async<Result<ResponseFile>> &async) {
+            const ResponseFile previous = m_responseFiles.value(project).value(shard);
+            // the cache lookup already checked which files exist, projects can list files that
+            // were removed in the meantime
+            const FilePaths existingFiles = Utils::filtered(qmlFiles, [storage](const FilePath &f) {
+                return storage->existingFiles.contains(f);
+            });
             async.setConcurrentCallData(
+                // returns no file if the previous one can be reused
                 [](const FilePath &qmlimportscanner,
                    const FilePaths &qmlFiles,
-                   const FilePaths &importPaths) -> Result<TemporaryFilePath *> {
-                    // Remove files that do not exist
-                    const FilePaths actualQmlFiles = Utils::filtered(qmlFiles, &FilePath::exists);
+                   const FilePaths &importPaths,
+                   const FilePath &previousPath,
+                   const QByteArray &previousDigest,
+                   qint64 previousSize) -> Result<ResponseFile> {
+                    const QByteArray contents = responseFileContents(qmlFiles, importPaths);
+                    const QByteArray digest
+                        = QCryptographicHash::hash(contents, QCryptographicHash::Sha1);
+                    if (!previousPath.isEmpty() && previousDigest == digest
+                        && previousPath.fileSize() == previousSize) {
+                        return ResponseFile{{}, digest, contents.size()};
+                    }
                     const Result<FilePath> tmpDir = qmlimportscanner.tmpDir();
                     if (!tmpDir)
                         return ResultError("Failed to determine temporary directory");
@@ -428,50 +696,70 @@ public:
                         return ResultError(
                             QString("Failed to create response file: %1").arg(tempPath.error()));
                     }
-                    QByteArrayList arguments = {"-qmlFiles"};
-                    for (const FilePath &file : actualQmlFiles)
-                        arguments << file.nativePath().toUtf8();
-                    for (const FilePath &importPath : importPaths)
-                        arguments << "-importPath" << importPath.nativePath().toUtf8();
                     if (Result<qint64> writeResult = (*tempPath)->filePath().writeFileContents(
-                            arguments.join('\n'));
+                            contents);
                         !writeResult) {
                         return ResultError(
                             QString("Failed to create response file: %1").arg(writeResult.error()));
                     }
-                    return tempPath->release();
+                    return ResponseFile{std::move(*tempPath), digest, contents.size()};
                 },
                 qmlimportscanner,
-                qmlFiles,
-                importPaths);
+                existingFiles,
+                importPaths,
+                previous.file ? previous.file->filePath() : FilePath(),
+                previous.digest,
+                previous.size);
         };
-        const auto done = [storage](const Async<Result<TemporaryFilePath *>> &async) {
-            Result<TemporaryFilePath *> result = async.result();
+        const auto done = [this, responseFile, project, shard](
+                              const Async<Result<ResponseFile>> &async) {
+            const Result<ResponseFile> result = async.result();
+            QHash<int, ResponseFile> &files = m_responseFiles[project];
             if (!result) {
                 qCDebug(qmlmodulesLog) << "Failed to set up qmlimportscanner:" << result.error();
+                releaseResponseFiles({files.take(shard)});
                 return QtTaskTree::DoneResult::Error;
             }
-            storage->reset(*result);
+            if (result->file) {
+                releaseResponseFiles({files.take(shard)});
+                files.insert(shard, *result);
+            }
+            const ResponseFile current = files.value(shard);
+            if (!current.file)
+                return QtTaskTree::DoneResult::Error;
+            *responseFile = current.file->filePath();
             return QtTaskTree::DoneResult::Success;
         };
-        return AsyncTask<Result<TemporaryFilePath *>>(setup, done);
+        return AsyncTask<Result<ResponseFile>>(setup, done);
+    }
+
+    // Removing the files can be a round trip to the device, so it is done on a worker thread,
+    // where the last references are dropped.
+    static void releaseResponseFiles(QList<ResponseFile> files)
+    {
+        files.removeIf([](const ResponseFile &file) { return !file.file; });
+        if (files.isEmpty())
+            return;
+        PluginManager::futureSynchronizer()->addFuture(
+            Utils::asyncRun([files = std::move(files)]() mutable { files.clear(); }));
+    }
+
+    void removeResponseFiles(Project *project)
+    {
+        releaseResponseFiles(m_responseFiles.take(project).values());
     }
 
     QtTaskTree::ExecutableItem runQmlImportScanner(
+        const ShardStorage &responseFile,
         const ScanStorage &storage,
-        const FilePath &qmlimportscanner,
-        const QString &projectId,
-        const QString &qtVersionString,
-        QInsightTracker *tracker)
+        const FilePath &qmlimportscanner)
     {
-        const auto setup = [qmlimportscanner, storage](Process &process) {
-            process.setCommand({qmlimportscanner, {"@" + (*storage)->filePath().nativePath()}});
+        const auto setup = [qmlimportscanner, responseFile](Process &process) {
+            process.setCommand(
+                {qmlimportscanner, {"@" + responseFile->nativePath()}});
+            ScanScheduler::setLowPriority(process);
         };
-        const auto done = [projectId,
-                           qtVersionString,
-                           tracker = QPointer<QInsightTracker>(tracker)](const Process &process) {
-            if (!tracker)
-                return;
+        const auto done = [storage](const Process &process) {
             QJsonParseError error;
             const auto doc = QJsonDocument::fromJson(process.rawStdOut(), &error);
             if (error.error != QJsonParseError::NoError) {
@@ -481,14 +769,13 @@ public:
                 qCDebug(qmlmodulesLog) << qPrintable(process.stdOut());
                 qCDebug(qmlmodulesLog) << "Stderr:";
                 qCDebug(qmlmodulesLog) << qPrintable(process.stdErr());
-                return;
+                return QtTaskTree::DoneResult::Error;
             }
             qCDebug(qmlmodulesLog) << "Response:" << qPrintable(QString::fromUtf8(doc.toJson()));
             if (!doc.isArray()) {
                 qCDebug(qmlmodulesLog) << "Unexpected response, not a JSON array";
-                return;
+                return QtTaskTree::DoneResult::Error;
             }
-            QStringList qmlModules;
             const QJsonArray array = doc.array();
             for (const QJsonValue &v : array) {
                 const QJsonObject obj = v.toObject();
@@ -502,29 +789,72 @@ public:
                     qCDebug(qmlmodulesLog) << "Skipping import with type \"" + type + "\"";
                     continue;
                 }
-                qmlModules += name;
+                storage->scannedModules.insert(name);
             }
-            if (qmlModules.isEmpty())
-                return;
-            // - the list of modules can contain all kinds of user defined modules too, since
-            //   we need to add the user import paths to catch the QDS modules
-            // - a hardcoded whitelist here would be ugly because older Qt Creator versions would
-            //   filter out new QML modules in newer Qt versions
-            // - so send a hash of the module "name" to telemetry, and the script that processes
-            //   that data has a mapping of hash -> known Qt module
-            const QStringList moduleHashes = Utils::transform(qmlModules, hashed);
-            QJsonObject json;
-            json.insert("projectid", projectId);
-            json.insert("qmlmodules", QJsonArray::fromStringList(moduleHashes));
-            json.insert("qtversion", qtVersionString);
-            const QString jsonStr = QString::fromUtf8(
-                QJsonDocument(json).toJson(QJsonDocument::Compact));
-            qCDebug(qmlmodulesLog) << qPrintable(jsonStr);
-            addEvent(tracker, "QmlModules", jsonStr);
+            return QtTaskTree::DoneResult::Success;
         };
         return ProcessTask(setup, done);
     }
 
+    void setScanResult(const ScanStorage &storage, const QStringList &qmlModules)
+    {
+        if (!storage->fingerprint.isEmpty()) {
+            // writing the entry and pruning the cache directory is file system work
+            PluginManager::futureSynchronizer()->addFuture(Utils::asyncRun(
+                [cache = m_cache, fingerprint = storage->fingerprint, qmlModules] {
+                    if (const Result<> stored = cache.store(fingerprint, qmlModules); !stored)
+                        qCDebug(qmlmodulesLog) << "Failed to cache scan result:" << stored.error();
+                }));
+        }
+        storage->modules = qmlModules;
+    }
+
+    static bool useInternalScanner()
+    {
+        static const bool enabled = fromEnvironment("QTC_USAGESTATISTIC_INTERNAL_QMLSCANNER", 0)
+                                    != 0;
+        return enabled;
+    }
+
+    void reportModules(
+        EventPipeline *events,
+        const QString &projectId,
+        const QString &qtVersionString,
+        const QStringList &qmlModules)
+    {
+        if (qmlModules.isEmpty())
+            return;
+        // the modules are sorted, so the fingerprint only changes with the set of modules
+        const QString key = projectId + ':' + qtVersionString;
+        const QByteArray fingerprint = FingerprintStore::fingerprint(qmlModules);
+        if (m_lastReported->contains(key, fingerprint)) {
+            qCDebug(qmlmodulesLog) << "QML modules unchanged for" << key;
+            return;
+        }
+        // - the list of modules can contain all kinds of user defined modules too, since
+        //   we need to add the user import paths to catch the QDS modules
+        // - a hardcoded whitelist here would be ugly because older Qt Creator versions would
+        //   filter out new QML modules in newer Qt versions
+        // - so send a hash of the module "name" to telemetry, and the script that processes
+        //   that data has a mapping of hash -> known Qt module
+        events->push(
+            {"QmlModules",
+             {{"projectid", projectId},
+              {"qmlmodules", EventRecord::HashedList{qmlModules}},
+              {"qtversion", qtVersionString}},
+             qmlmodulesLog,
+             [store = m_lastReported, key, fingerprint] { store->update(key, fingerprint); }});
+    }
+
+    static void precomputeDigests()
+    {
+        const FilePaths qmlPaths = Utils::transform(QtVersionManager::versions(), [](QtVersion *v) {
+            return v->qmlPath();
+        });
+        PluginManager::futureSynchronizer()->addFuture(
+            Utils::asyncRun(precomputeModuleDigests, qmlPaths));
+    }
+
     bool shouldStartCollectingFor(Project *project)
     {
         if (!BuildManager::isBuilding(project)) {
@@ -535,49 +865,246 @@ public:
             return false;
 
         // don't interrupt a running scan
-        return !m_runner.isKeyRunning(project);
+        return !m_scheduler->isScheduled(project);
     }
 
+    QmlModulesCache m_cache{ICore::cacheResourcePath("usagestatistic/qmlmodules")};
+    std::shared_ptr<FingerprintStore> m_lastReported = std::make_shared<FingerprintStore>(
+        ICore::cacheResourcePath(kQmlModulesFingerprints));
     QHash<BuildConfiguration *, QmlCodeModelInfo> m_qmlCodeModelInfo;
     QSet<Project *> m_buildingProjects;
-    QtTaskTree::QMappedTaskTreeRunner<Project *> m_runner;
+    QHash<Project *, QHash<int, ResponseFile>> m_responseFiles; // by shard
+    ScanScheduler *m_scheduler = nullptr;
+    QmlFileIndex *m_fileIndex = nullptr;
+    ProviderStats &m_stats = providerStats("QmlModules");
 };
 
 class QtExample : public QObject
 {
     Q_OBJECT
 public:
-    QtExample(QInsightTracker *tracker)
+    QtExample(EventPipeline *events, ProjectObserver *observer)
     {
-        connect(ProjectManager::instance(),
-                &ProjectManager::projectAdded,
-                this,
-                [this, tracker](Project *project) {
-                    connect(project, &Project::anyParsingFinished, this, [project, tracker] {
-                        const QtVersions versions = QtVersionManager::versions();
-                        for (QtVersion *qtVersion : versions) {
-                            const FilePath examplesPath = qtVersion->examplesPath();
-                            if (examplesPath.isEmpty())
-                                continue;
-                            if (!project->projectFilePath().isChildOf(examplesPath))
-                                continue;
-                            const FilePath examplePath = project->projectFilePath()
-                                                             .relativeChildPath(examplesPath)
-                                                             .parentDir();
-                            const QString exampleHash = hashed(examplePath.path());
-                            QJsonObject json;
-                            json.insert("projectid", projectId(project));
-                            json.insert("qtexample", exampleHash);
-                            json.insert("qtversion", qtVersion->qtVersion().toString());
-                            const QString jsonStr = QString::fromUtf8(
-                                QJsonDocument(json).toJson(QJsonDocument::Compact));
-                            qCDebug(qtexampleLog) << qPrintable(jsonStr);
-                            addEvent(tracker, "QtExample", jsonStr);
-                            return;
-                        }
-                    });
-                });
+        connect(
+            observer,
+            &ProjectObserver::projectParsed,
+            this,
+            [this, events](const ProjectSnapshot &snapshot) {
+                const HandlerTimer timer(m_stats);
+                const std::optional<QtExamplesIndex::Example> example = m_examples.find(
+                    snapshot.projectFilePath);
+                if (!example)
+                    return;
+                events->push(
+                    {"QtExample",
+                     {{"projectid", snapshot.projectId},
+                      {"qtexample", EventRecord::Hashed{example->examplePath.path()}},
+                      {"qtversion", example->qtVersion}},
+                     qtexampleLog});
+            });
+    }
+
+private:
+    QtExamplesIndex m_examples;
+    ProviderStats &m_stats = providerStats("QtExample");
+};
+
+// Durations of builds in milliseconds, per build system and build device type. The durations of
+// project parsing are reported by ParseTimes, with the same dimensions.
+class BuildDurations : public QObject
+{
+    Q_OBJECT
+public:
+    BuildDurations(EventPipeline *events, ProjectObserver *observer)
+        : m_events(events)
+        , m_observer(observer)
+    {
+        connect(
+            BuildManager::instance(),
+            &BuildManager::buildStateChanged,
+            this,
+            [this](Project *project) {
+                const HandlerTimer timer(m_stats);
+                if (BuildManager::isBuilding(project)) {
+                    if (!m_builds.contains(project) && !m_queued.contains(project)) {
+                        if (m_builds.isEmpty())
+                            m_builds[project].start();
+                        else
+                            m_queued.append(project);
+                    }
+                    return;
+                }
+                m_queued.removeOne(project);
+                const auto it = m_builds.constFind(project);
+                if (it == m_builds.cend())
+                    return;
+                add(project, it->elapsed());
+                m_builds.erase(it);
+                startNextBuild();
+            });
+        connect(
+            ProjectManager::instance(),
+            &ProjectManager::aboutToRemoveProject,
+            this,
+            [this](Project *project) {
+                m_queued.removeOne(project);
+                if (m_builds.remove(project))
+                    startNextBuild();
+            });
+
+        m_summaryTimer.setInterval(summaryInterval());
+        connect(&m_summaryTimer, &QTimer::timeout, this, &BuildDurations::reportSummary);
+        m_summaryTimer.start();
+    }
+
+    ~BuildDurations() override { reportSummary(); }
+
+private:
+    // The build manager runs the steps of the queued projects one after the other, so the build
+    // of a queued project starts when the build of the previous one finished. Time spent waiting
+    // in the queue is not build time.
+    void startNextBuild()
+    {
+        if (m_builds.isEmpty() && !m_queued.isEmpty())
+            m_builds[m_queued.takeFirst()].start();
+    }
+
+    void add(Project *project, qint64 msecs)
+    {
+        QString buildSystemName = "None";
+        QString deviceType = "None";
+        if (BuildSystem *buildSystem = project->activeBuildSystem()) {
+            buildSystemName = buildSystem->name();
+            if (const auto kit = m_observer->kitSnapshot(buildSystem->kit()))
+                deviceType = kit->buildDeviceType;
+        }
+        const QString key = QString("%1:%2").arg(buildSystemName, deviceType);
+        qCDebug(statLog) << "Build duration for" << key << msecs << "ms";
+        m_histograms[key].add(msecs);
+    }
+
+    void reportSummary()
+    {
+        if (m_histograms.isEmpty())
+            return;
+        EventRecord record{"BuildDurations", {}, statLog};
+        for (auto it = m_histograms.cbegin(); it != m_histograms.cend(); ++it)
+            record.fields.append({it.key(), it.value().summary()});
+        m_histograms.clear();
+        m_events->push(std::move(record));
+    }
+
+    EventPipeline *m_events = nullptr;
+    ProjectObserver *m_observer = nullptr;
+    QHash<Project *, QElapsedTimer> m_builds;
+    QList<Project *> m_queued; // waiting for the builds in m_builds
+    QMap<QString, LogLinearHistogram> m_histograms;
+    QTimer m_summaryTimer;
+    ProviderStats &m_stats = providerStats("BuildDurations");
+};
+
+// Durations of project parsing in milliseconds and the number of files of the parsed projects,
+// per build system and build device type.
+class ParseTimes : public QObject
+{
+    Q_OBJECT
+public:
+    ParseTimes(EventPipeline *events, ProjectObserver *observer, QmlFileIndex *fileIndex)
+        : m_events(events)
+        , m_fileIndex(fileIndex)
+    {
+        connect(
+            observer,
+            &ProjectObserver::projectParsingStarted,
+            this,
+            [this](Project *project) { m_parses[project].start(); });
+        connect(
+            observer,
+            &ProjectObserver::projectParsed,
+            this,
+            [this](const ProjectSnapshot &snapshot) {
+                const HandlerTimer timer(m_stats);
+                const auto it = m_parses.constFind(snapshot.project);
+                if (it == m_parses.cend())
+                    return;
+                const QString buildSystemName = snapshot.buildSystemName.isEmpty()
+                                                    ? QString("None")
+                                                    : snapshot.buildSystemName;
+                const QString deviceType = snapshot.kit ? snapshot.kit->buildDeviceType
+                                                        : QString("None");
+                const Parse parse{QString("%1:%2").arg(buildSystemName, deviceType), it->elapsed()};
+                m_parses.erase(it);
+                m_waitingForFiles[snapshot.project].append(parse);
+            });
+        connect(
+            ProjectManager::instance(),
+            &ProjectManager::aboutToRemoveProject,
+            this,
+            [this](Project *project) {
+                const HandlerTimer timer(m_stats);
+                m_parses.remove(project);
+                addWaiting(project);
+            });
+
+        m_summaryTimer.setInterval(summaryInterval());
+        connect(&m_summaryTimer, &QTimer::timeout, this, &ParseTimes::reportSummary);
+        m_summaryTimer.start();
     }
+
+    ~ParseTimes() override { reportSummary(); }
+
+private:
+    struct Parse
+    {
+        QString key; // build system and build device type
+        qint64 msecs = 0;
+    };
+    struct Aggregate
+    {
+        LogLinearHistogram durations;
+        LogLinearHistogram fileCounts;
+    };
+
+    // Walking the project tree for the number of files is expensive, so the parses of a project
+    // are only added with the number of files it has when the summary is sent or the project
+    // is closed. The tree is walked at most once per project and summary.
+    void addWaiting(Project *project)
+    {
+        const QList<Parse> parses = m_waitingForFiles.take(project);
+        if (parses.isEmpty())
+            return;
+        const int fileCount = m_fileIndex->sourceFileCount(project);
+        for (const Parse &parse : parses) {
+            qCDebug(statLog) << "Parsing" << project->displayName() << "with" << fileCount
+                             << "files took" << parse.msecs << "ms";
+            Aggregate &aggregate = m_aggregates[parse.key];
+            aggregate.durations.add(parse.msecs);
+            aggregate.fileCounts.add(fileCount);
+        }
+    }
+
+    void reportSummary()
+    {
+        for (Project *project : m_waitingForFiles.keys())
+            addWaiting(project);
+        if (m_aggregates.isEmpty())
+            return;
+        EventRecord record{"ParseTimes", {}, statLog};
+        for (auto it = m_aggregates.cbegin(); it != m_aggregates.cend(); ++it) {
+            record.fields.append({it.key() + ":duration", it->durations.summary()});
+            record.fields.append({it.key() + ":files", it->fileCounts.summary()});
+        }
+        m_aggregates.clear();
+        m_events->push(std::move(record));
+    }
+
+    EventPipeline *m_events = nullptr;
+    QmlFileIndex *m_fileIndex = nullptr;
+    QHash<Project *, QElapsedTimer> m_parses;
+    QHash<Project *, QList<Parse>> m_waitingForFiles; // parsed, but the files are not counted yet
+    QMap<QString, Aggregate> m_aggregates; // per build system and build device type
+    QTimer m_summaryTimer;
+    ProviderStats &m_stats = providerStats("ParseTimes");
 };
 
 static const char licenseKey[] = "QtLicenseSchema";
@@ -595,7 +1122,7 @@ public:
     {
         QObject *licensechecker = getLicensechecker();
         if (!licensechecker) {
-            addEvent(tracker, licenseKey, "opensource");
+            addEvent(m_stats, tracker, licenseKey, "opensource");
             return;
         }
         connect(
@@ -624,29 +1151,95 @@ private slots:
                 "licenseSchema",
                 Qt::DirectConnection,
                 Q_RETURN_ARG(QString, schema)));
-        addEvent(m_tracker, licenseKey, schema);
+        addEvent(m_stats, m_tracker, licenseKey, schema);
     }
 
 private:
     QInsightTracker *m_tracker = nullptr;
+    ProviderStats &m_stats = providerStats("QtLicense");
 };
 
 class Wizard : public QObject
 {
     Q_OBJECT
 public:
-    Wizard(QInsightTracker *tracker)
-    {
-        connect(ICore::instance(), &ICore::wizardFinished, this, [tracker](const Utils::Id &id, bool accepted) {
-            QJsonObject json;
-            json.insert("id", hashed(id.toString()));
-            json.insert("accepted", accepted);
-            const QString jsonStr = QString::fromUtf8(
-                QJsonDocument(json).toJson(QJsonDocument::Compact));
-            qCDebug(projectWizardLog) << qPrintable(jsonStr);
-            addEvent(tracker, "Wizard", jsonStr);
+    Wizard(EventPipeline *events)
+    {
+        connect(
+            ICore::instance(),
+            &ICore::wizardFinished,
+            this,
+            [this, events](const Utils::Id &id, bool accepted) {
+                const HandlerTimer timer(m_stats);
+                events->push(
+                    {"Wizard",
+                     {{"id", EventRecord::Hashed{id.toString()}}, {"accepted", accepted}},
+                     projectWizardLog});
+            });
+    }
+
+private:
+    ProviderStats &m_stats = providerStats("Wizard");
+};
+
+// Measures the latency of the GUI event loop with a heartbeat timer. Delays above a threshold
+// are recorded in milliseconds per mode, and sent as one summary per submission interval.
+class Stalls : public QObject
+{
+    Q_OBJECT
+public:
+    Stalls(EventPipeline *events)
+        : m_events(events)
+        , m_threshold(fromEnvironment("QTC_USAGESTATISTIC_STALL_THRESHOLD_MS", 100))
+    {
+        // a coarse timer is good enough for stalls that are much longer than its tolerance
+        m_heartbeat.setTimerType(Qt::CoarseTimer);
+        m_heartbeat.setInterval(fromEnvironment("QTC_USAGESTATISTIC_HEARTBEAT_MS", 250));
+        connect(&m_heartbeat, &QTimer::timeout, this, &Stalls::beat);
+        m_heartbeat.start();
+        m_sinceLastBeat.start();
+        // timers of inactive or suspended applications are throttled, which is not a stall
+        connect(qGuiApp, &QGuiApplication::applicationStateChanged, this, [this] {
+            m_sinceLastBeat.restart();
         });
+
+        m_summaryTimer.setInterval(summaryInterval());
+        connect(&m_summaryTimer, &QTimer::timeout, this, &Stalls::reportSummary);
+        m_summaryTimer.start();
     }
+
+    ~Stalls() override { reportSummary(); }
+
+private:
+    void beat()
+    {
+        const qint64 delay = m_sinceLastBeat.restart() - m_heartbeat.interval();
+        if (delay < m_threshold || QGuiApplication::applicationState() != Qt::ApplicationActive)
+            return;
+        const HandlerTimer timer(m_stats);
+        const QString mode = QString::fromUtf8(ModeManager::currentModeId().name());
+        qCDebug(statLog) << "Event loop stalled for" << delay << "ms in mode" << mode;
+        m_histograms[mode].add(delay);
+    }
+
+    void reportSummary()
+    {
+        if (m_histograms.isEmpty())
+            return;
+        EventRecord record{"Stalls", {{"threshold", qint64(m_threshold)}}, statLog};
+        for (auto it = m_histograms.cbegin(); it != m_histograms.cend(); ++it)
+            record.fields.append({it.key(), it.value().summary()});
+        m_histograms.clear();
+        m_events->push(std::move(record));
+    }
+
+    EventPipeline *m_events = nullptr;
+    const int m_threshold = 0; // ms
+    QTimer m_heartbeat;
+    QElapsedTimer m_sinceLastBeat;
+    QMap<QString, LogLinearHistogram> m_histograms; // per mode
+    QTimer m_summaryTimer;
+    ProviderStats &m_stats = providerStats("Stalls");
 };
 
 static QString consentText()
@@ -670,6 +1263,31 @@ static QString moreInformationText()
            + UsageStatisticPlugin::tr("More information") + "</a>";
 }
 
+static FilePath insightStoragePath()
+{
+    return ICore::cacheResourcePath("insight");
+}
+
+static QString storageUsageText()
+{
+    return UsageStatisticPlugin::tr("Currently used: %1")
+        .arg(QLocale::system().formattedDataSize(InsightStorage(insightStoragePath()).usage()));
+}
+
+static QString statsText()
+{
+    QStringList report = providerStatsReport();
+    if (report.isEmpty())
+        return UsageStatisticPlugin::tr("No providers are running.");
+    if (const ScanScheduler *scheduler = m_instance->scanScheduler()) {
+        report.append(UsageStatisticPlugin::tr("Scan queue: %1 queued, %2 running (at most %3)")
+                          .arg(scheduler->queueDepth())
+                          .arg(scheduler->runningCount())
+                          .arg(scheduler->maxConcurrentScans()));
+    }
+    return report.join('\n');
+}
+
 class Settings : public AspectContainer
 {
 public:
@@ -685,8 +1303,31 @@ public:
             writeToSettingsImmediatly(); // write the updated "TrackingEnabled" value to the .ini
             m_instance->configureInsight();
         });
+        storageQuota.setSettingsKey("StorageQuota");
+        storageQuota.setDefaultValue(50);
+        storageQuota.setRange(1, 1024);
+        storageQuota.setSuffix(UsageStatisticPlugin::tr(" MB"));
+        storageQuota.setLabelText(UsageStatisticPlugin::tr("Maximum size of unsent data:"));
+        storageQuota.addOnChanged(this, [] { m_instance->applyStorageQuota(); });
         setLayouter([this] {
             using namespace Layouting;
+            auto usageLabel = new QLabel(storageUsageText());
+            auto purgeButton = new QPushButton(UsageStatisticPlugin::tr("Purge Cache"));
+            auto statsLabel = new QLabel(statsText());
+            statsLabel->setTextInteractionFlags(Qt::TextSelectableByMouse);
+            auto refreshButton = new QPushButton(UsageStatisticPlugin::tr("Refresh"));
+            QObject::connect(refreshButton, &QPushButton::clicked, statsLabel, [statsLabel] {
+                statsLabel->setText(statsText());
+            });
+            auto logButton = new QPushButton(UsageStatisticPlugin::tr("Write to Log"));
+            logButton->setToolTip(
+                UsageStatisticPlugin::tr("Logs the counters under the \"qtc.usagestatistic\" "
+                                         "logging category."));
+            QObject::connect(logButton, &QPushButton::clicked, [] { logProviderStats(); });
+            QObject::connect(purgeButton, &QPushButton::clicked, usageLabel, [usageLabel] {
+                m_instance->purgeCache();
+                usageLabel->setText(storageUsageText());
+            });
             // clang-format off
             Column col{
                 trackingEnabled,
@@ -704,6 +1345,20 @@ public:
                         },
                         st
                     }
+                },
+                Group {
+                    title(UsageStatisticPlugin::tr("Local Cache")),
+                    Column {
+                        Row { storageQuota, st },
+                        Row { usageLabel, purgeButton, st }
+                    }
+                },
+                Group {
+                    title(UsageStatisticPlugin::tr("Diagnostics")),
+                    Column {
+                        statsLabel,
+                        Row { refreshButton, logButton, st }
+                    }
                 }
             };
             // clang-format on
@@ -715,6 +1370,7 @@ public:
     }
 
     Utils::BoolAspect trackingEnabled{this};
+    Utils::IntegerAspect storageQuota{this}; // in MB
 };
 
 static Settings &theSettings()
@@ -743,6 +1399,8 @@ static void setupSettingsPage()
 UsageStatisticPlugin::UsageStatisticPlugin()
 {
     m_instance = this;
+    m_startupTimer.setInterval(0);
+    connect(&m_startupTimer, &QTimer::timeout, this, &UsageStatisticPlugin::runNextStartupStep);
     Core::IOptionsPage::registerCategory(
         "Telemetry",
         UsageStatisticPlugin::tr("Telemetry"),
@@ -774,28 +1432,39 @@ bool UsageStatisticPlugin::delayedInitialize()
 ExtensionSystem::IPlugin::ShutdownFlag UsageStatisticPlugin::aboutToShutdown()
 {
     theSettings().writeSettings();
+    logProviderStats();
 
     return SynchronousShutdown;
 }
 
-static constexpr int defaultSubmissionInterval()
+static constexpr int defaultBatchSize()
 {
-    using namespace std::literals;
-    return std::chrono::hours(1) / 1s;
+    return 100;
 }
 
-static constexpr int defaultBatchSize()
+// silence qt.insight.*.info logging category if logging for usagestatistic is not enabled
+// the issue here is, that qt.insight.*.info is enabled by default and spams terminals
+static std::optional<QLoggingCategory::CategoryFilter> previousFilter;
+
+static void silenceInsightLogging()
 {
-    return 100;
+    if (statLog().isDebugEnabled() || previousFilter)
+        return;
+    previousFilter = QLoggingCategory::installFilter([](QLoggingCategory *log) {
+        if (previousFilter && *previousFilter != nullptr)
+            (*previousFilter)(log);
+        if (QString::fromUtf8(log->categoryName()).startsWith("qt.insight"))
+            log->setEnabled(QtInfoMsg, false);
+    });
 }
 
-static int fromEnvironment(const QString &key, int defaultValue)
+static void restoreLogging()
 {
-    bool ok = false;
-    const int env = qtcEnvironmentVariableIntValue(key, &ok);
-    if (ok)
-        return env;
-    return defaultValue;
+    // reinstall previous logging filter if required
+    if (previousFilter) {
+        QLoggingCategory::installFilter(*previousFilter);
+        previousFilter.reset();
+    }
 }
 
 void UsageStatisticPlugin::configureInsight()
@@ -803,51 +1472,100 @@ void UsageStatisticPlugin::configureInsight()
     qCDebug(statLog) << "Configuring insight, enabled:" << theSettings().trackingEnabled.value();
     if (theSettings().trackingEnabled.value()) {
         if (!m_tracker || !m_tracker->isEnabled()) {
-            // silence qt.insight.*.info logging category if logging for usagestatistic is not enabled
-            // the issue here is, that qt.insight.*.info is enabled by default and spams terminals
-            static std::optional<QLoggingCategory::CategoryFilter> previousFilter;
-            if (!statLog().isDebugEnabled()) {
-                previousFilter = QLoggingCategory::installFilter([](QLoggingCategory *log) {
-                    if (previousFilter && *previousFilter != nullptr)
-                        (*previousFilter)(log);
-                    if (QString::fromUtf8(log->categoryName()).startsWith("qt.insight"))
-                        log->setEnabled(QtInfoMsg, false);
-                });
-            }
-
-            qCDebug(statLog) << "Creating tracker";
-            m_tracker.reset(new QInsightTracker);
-            QInsightConfiguration *config = m_tracker->configuration();
-            config->setEvents({}); // the default is a big list including key events....
-            config->setStoragePath(ICore::cacheResourcePath("insight").path());
-            qCDebug(statLog) << "Cache path:" << config->storagePath();
-            // TODO provide a button for removing the cache?
-            // TODO config->setStorageSize(???); // unlimited by default
-            config->setSyncInterval(
-                fromEnvironment("QTC_INSIGHT_SUBMISSIONINTERVAL", defaultSubmissionInterval()));
-            config->setBatchSize(fromEnvironment("QTC_INSIGHT_BATCHSIZE", defaultBatchSize()));
-            config->setDeviceModel(QString("%1 (%2)").arg(QSysInfo::productType(),
-                                                          QSysInfo::currentCpuArchitecture()));
-            config->setDeviceVariant(QSysInfo::productVersion());
-            config->setDeviceScreenType("NON_TOUCH");
-            config->setPlatform("app"); // see "Snowplow Tracker Protocol"
-            config->setAppBuild(appInfo().displayVersion);
-            config->setServer(QTC_INSIGHT_URL);
-            config->setToken(QTC_INSIGHT_TOKEN);
-            m_tracker->setEnabled(true);
-            createProviders();
-            m_tracker->startNewSession();
-
-            // reinstall previous logging filter if required
-            if (previousFilter)
-                QLoggingCategory::installFilter(*previousFilter);
+            silenceInsightLogging();
+            resetTracker();
+            scheduleStartup();
         }
     } else {
-        if (m_tracker)
+        if (!m_startupSteps.isEmpty())
+            resetTracker(); // not completely started yet
+        else if (m_tracker)
             m_tracker->setEnabled(false);
     }
 }
 
+void UsageStatisticPlugin::createTracker()
+{
+    // the tracker itself keeps the data below the quota that is set in applyStorageQuota()
+    qCDebug(statLog) << "Cache usage:" << InsightStorage(insightStoragePath()).usage() << "bytes";
+
+    qCDebug(statLog) << "Creating tracker";
+    m_tracker.reset(new QInsightTracker);
+    QInsightConfiguration *config = m_tracker->configuration();
+    config->setEvents({}); // the default is a big list including key events....
+    config->setStoragePath(insightStoragePath().path());
+    qCDebug(statLog) << "Cache path:" << config->storagePath();
+    applyStorageQuota();
+    config->setSyncInterval(
+        fromEnvironment("QTC_INSIGHT_SUBMISSIONINTERVAL", defaultSubmissionInterval()));
+    config->setBatchSize(fromEnvironment("QTC_INSIGHT_BATCHSIZE", defaultBatchSize()));
+    config->setDeviceModel(QString("%1 (%2)").arg(QSysInfo::productType(),
+                                                  QSysInfo::currentCpuArchitecture()));
+    config->setDeviceVariant(QSysInfo::productVersion());
+    config->setDeviceScreenType("NON_TOUCH");
+    config->setPlatform("app"); // see "Snowplow Tracker Protocol"
+    config->setAppBuild(appInfo().displayVersion);
+#ifdef WITH_TESTS
+    // developer builds can send to a different backend, e.g. a local server for measurements,
+    // release builds only ever send to the one they were built for
+    config->setServer(fromEnvironment("QTC_INSIGHT_URL", QTC_INSIGHT_URL));
+    config->setToken(fromEnvironment("QTC_INSIGHT_TOKEN", QTC_INSIGHT_TOKEN));
+#else
+    config->setServer(QTC_INSIGHT_URL);
+    config->setToken(QTC_INSIGHT_TOKEN);
+#endif
+    qCDebug(statLog) << "Server:" << config->server() << "batch size:" << config->batchSize()
+                     << "sync interval:" << config->syncInterval();
+    m_tracker->setEnabled(true);
+    m_eventPipeline = std::make_unique<EventPipeline>(m_tracker.get());
+}
+
+qint64 UsageStatisticPlugin::storageQuota() const
+{
+    return qint64(theSettings().storageQuota()) * 1024 * 1024;
+}
+
+void UsageStatisticPlugin::applyStorageQuota()
+{
+    if (m_tracker) {
+        m_tracker->configuration()->setStorageSize(
+            int(std::min<qint64>(storageQuota(), std::numeric_limits<int>::max())));
+    }
+}
+
+void UsageStatisticPlugin::resetTracker()
+{
+    if (!m_startupSteps.isEmpty()) {
+        m_startupSteps.clear();
+        m_startupTimer.stop();
+        restoreLogging();
+    }
+    // providers and the event pipeline refer to the tracker,
+    // running scans refer to the providers
+    m_scanScheduler.reset();
+    m_providers.clear();
+    m_eventPipeline.reset();
+    m_tracker.reset();
+}
+
+void UsageStatisticPlugin::purgeCache()
+{
+    // the tracker keeps its storage open, so recreate it after purging
+    const bool wasEnabled = m_tracker && m_tracker->isEnabled();
+    resetTracker();
+    if (const Result<> purged = InsightStorage(insightStoragePath()).purge(); !purged)
+        qCWarning(statLog) << "Failed to purge the cache:" << purged.error();
+    // the providers saved their fingerprints when they were destroyed above, forget them,
+    // so the data that was dropped with the cache is reported again
+    for (const char *fingerprints : {kBuildConfigFingerprints, kQmlModulesFingerprints}) {
+        const FilePath file = ICore::cacheResourcePath(fingerprints);
+        if (const Result<> removed = file.removeFile(); !removed && file.exists())
+            qCWarning(statLog) << "Failed to purge the cache:" << removed.error();
+    }
+    if (wasEnabled)
+        configureInsight();
+}
+
 static std::optional<bool> installerUserFeedbackEnabled()
 {
     constexpr char kUserFeedback[] = "UserFeedback/StatisticsCollectionMode";
@@ -946,29 +1664,82 @@ void UsageStatisticPlugin::showInfoBar()
     infoBar->addInfo(entry);
 }
 
-void UsageStatisticPlugin::createProviders()
+void UsageStatisticPlugin::scheduleStartup()
 {
-    // startup configs first, otherwise they will be attributed to the UI state
-    m_providers.push_back(std::make_unique<Theme>(m_tracker.get()));
+    // Everything is created in small steps when the event loop is idle, so enabling
+    // the telemetry does not delay the startup of the IDE
+    const auto provider = [this](const auto &create) {
+        return [this, create] { m_providers.push_back(create()); };
+    };
+    m_startupSteps = {
+        {"Tracker", [this] { createTracker(); }},
+        // startup configs first, otherwise they will be attributed to the UI state
+        {"Theme", provider([this] { return std::make_unique<Theme>(m_tracker.get()); })},
+        {"UILanguage", provider([this] { return std::make_unique<UILanguage>(m_tracker.get()); })},
+        {"QtLicense", provider([this] { return std::make_unique<QtLicense>(m_tracker.get()); })}};
     // module and example telemetry require QInsightTracker::contextData to
     // work reliably, because the key of QInsightTracker::interaction is limited to 255 characters.
 #if QT_VERSION >= QTVERSION_WITH_CONTEXTDATA
-    m_providers.push_back(std::make_unique<BuildConfig>(m_tracker.get()));
-    m_providers.push_back(std::make_unique<QtExample>(m_tracker.get()));
-    m_providers.push_back(std::make_unique<QmlModules>(m_tracker.get()));
+    m_startupSteps.append(
+        {"ProjectObserver", [this] { m_projectObserver = std::make_unique<ProjectObserver>(); }});
+    m_startupSteps.append({"BuildConfig", provider([this] {
+                               return std::make_unique<BuildConfig>(
+                                   m_eventPipeline.get(), m_projectObserver.get());
+                           })});
+    m_startupSteps.append({"QtExample", provider([this] {
+                               return std::make_unique<QtExample>(
+                                   m_eventPipeline.get(), m_projectObserver.get());
+                           })});
+    m_startupSteps.append({"BuildDurations", provider([this] {
+                               return std::make_unique<BuildDurations>(
+                                   m_eventPipeline.get(), m_projectObserver.get());
+                           })});
+    m_startupSteps.append(
+        {"QmlFileIndex", [this] { m_qmlFileIndex = std::make_unique<QmlFileIndex>(); }});
+    m_startupSteps.append({"ParseTimes", provider([this] {
+                               return std::make_unique<ParseTimes>(
+                                   m_eventPipeline.get(),
+                                   m_projectObserver.get(),
+                                   m_qmlFileIndex.get());
+                           })});
+    m_startupSteps.append(
+        {"ScanScheduler", [this] { m_scanScheduler = std::make_unique<ScanScheduler>(); }});
+    m_startupSteps.append({"QmlModules", provider([this] {
+                               return std::make_unique<QmlModules>(
+                                   m_eventPipeline.get(),
+                                   m_scanScheduler.get(),
+                                   m_qmlFileIndex.get());
+                           })});
 #endif
-
-    m_providers.push_back(std::make_unique<UILanguage>(m_tracker.get()));
-    m_providers.push_back(std::make_unique<QtLicense>(m_tracker.get()));
-    m_providers.push_back(std::make_unique<Wizard>(m_tracker.get()));
-
+    m_startupSteps.append(
+        {"Wizard", provider([this] { return std::make_unique<Wizard>(m_eventPipeline.get()); })});
+    m_startupSteps.append(
+        {"Stalls", provider([this] { return std::make_unique<Stalls>(m_eventPipeline.get()); })});
     // UI state last
-    m_providers.push_back(std::make_unique<ModeChanges>(m_tracker.get()));
+    m_startupSteps.append({"ModeChanges", provider([this] {
+                               return std::make_unique<ModeChanges>(
+                                   m_tracker.get(), m_eventPipeline.get());
+                           })});
+    m_startupSteps.append({"Session", [this] {
+                               m_tracker->startNewSession();
+                               restoreLogging();
+                           }});
+    m_startupTimer.start();
+}
 
-    for (const auto &provider : m_providers) {
-        qCDebug(statLog) << "Created usage statistics provider"
-                         << provider.get()->metaObject()->className();
+void UsageStatisticPlugin::runNextStartupStep()
+{
+    if (m_startupSteps.isEmpty()) {
+        m_startupTimer.stop();
+        return;
     }
+    const auto [name, step] = m_startupSteps.takeFirst();
+    QElapsedTimer timer;
+    timer.start();
+    step();
+    qCDebug(statLog) << "Startup step" << name << "took" << timer.nsecsElapsed() / 1000 << "us";
+    if (m_startupSteps.isEmpty())
+        m_startupTimer.stop();
 }
 
 } // namespace UsageStatistic::Internal
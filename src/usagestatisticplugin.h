@@ -3,11 +3,14 @@
 
 #pragma once
 
+#include <functional>
 #include <memory>
 
 #include <extensionsystem/iplugin.h>
 
+#include <QList>
 #include <QObject>
+#include <QTimer>
 
 QT_BEGIN_NAMESPACE
 class QInsightTracker;
@@ -15,6 +18,10 @@ QT_END_NAMESPACE
 
 namespace UsageStatistic::Internal {
 
+class EventPipeline;
+class ProjectObserver;
+class QmlFileIndex;
+class ScanScheduler;
 class UsageStatisticPage;
 
 //! Plugin for collecting and sending usage statistics
@@ -33,15 +40,29 @@ public:
     ShutdownFlag aboutToShutdown() override;
 
     void configureInsight();
+    void applyStorageQuota();
+    void purgeCache();
+
+    const ScanScheduler *scanScheduler() const { return m_scanScheduler.get(); }
 
 private:
     void showInfoBar();
 
-    void createProviders();
+    void createTracker();
+    void scheduleStartup();
+    void runNextStartupStep();
+    void resetTracker();
+    qint64 storageQuota() const;
 
 private:
     std::unique_ptr<QInsightTracker> m_tracker;
+    std::unique_ptr<EventPipeline> m_eventPipeline;
+    std::unique_ptr<ProjectObserver> m_projectObserver;
+    std::unique_ptr<QmlFileIndex> m_qmlFileIndex; // shared by the providers
     std::vector<std::unique_ptr<QObject>> m_providers;
+    std::unique_ptr<ScanScheduler> m_scanScheduler; // running scans refer to the providers
+    QList<std::pair<QString, std::function<void()>>> m_startupSteps;
+    QTimer m_startupTimer;
 };
 
 } // namespace UsageStatistic::Internal
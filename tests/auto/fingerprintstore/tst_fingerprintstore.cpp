@@ -0,0 +1,102 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include <fingerprintstore.h>
+
+#include <QLoggingCategory>
+#include <QTemporaryDir>
+#include <QTest>
+
+#include <memory>
+
+// defined by the plugin
+Q_LOGGING_CATEGORY(statLog, "qtc.usagestatistic", QtWarningMsg);
+
+using namespace UsageStatistic::Internal;
+using namespace Utils;
+
+class tst_FingerprintStore : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void init();
+    void fingerprint();
+    void update();
+    void persistence();
+    void savesOnlyChanges();
+    void brokenFile();
+
+private:
+    std::unique_ptr<QTemporaryDir> m_dir;
+    FilePath m_file;
+};
+
+void tst_FingerprintStore::init()
+{
+    m_dir = std::make_unique<QTemporaryDir>();
+    QVERIFY(m_dir->isValid());
+    m_file = FilePath::fromString(m_dir->filePath("store/fingerprints.json"));
+}
+
+void tst_FingerprintStore::fingerprint()
+{
+    const QByteArray fingerprint = FingerprintStore::fingerprint({"Qt6Core", "6.8.0"});
+    QCOMPARE(FingerprintStore::fingerprint({"Qt6Core", "6.8.0"}), fingerprint);
+    QVERIFY(FingerprintStore::fingerprint({"6.8.0", "Qt6Core"}) != fingerprint);
+    // the values are separated, so moving characters between them changes the fingerprint
+    QVERIFY(FingerprintStore::fingerprint({"Qt6Cor", "e6.8.0"}) != fingerprint);
+    QVERIFY(FingerprintStore::fingerprint({"Qt6Core6.8.0"}) != fingerprint);
+}
+
+void tst_FingerprintStore::update()
+{
+    FingerprintStore store(m_file);
+    const QByteArray first = FingerprintStore::fingerprint({"first"});
+    const QByteArray second = FingerprintStore::fingerprint({"second"});
+
+    QVERIFY(!store.contains("project", first));
+    QVERIFY(store.update("project", first));
+    QVERIFY(store.contains("project", first));
+    QVERIFY(!store.update("project", first));
+    QVERIFY(store.update("project", second));
+    QVERIFY(!store.contains("project", first));
+    QVERIFY(!store.contains("other", second));
+}
+
+void tst_FingerprintStore::persistence()
+{
+    const QByteArray fingerprint = FingerprintStore::fingerprint({"value"});
+    {
+        FingerprintStore store(m_file);
+        store.update("project", fingerprint);
+    }
+    QVERIFY(m_file.exists());
+
+    const FingerprintStore store(m_file);
+    QVERIFY(store.contains("project", fingerprint));
+}
+
+void tst_FingerprintStore::savesOnlyChanges()
+{
+    {
+        FingerprintStore store(m_file);
+        QVERIFY(!store.contains("project", FingerprintStore::fingerprint({"value"})));
+    }
+    QVERIFY(!m_file.exists());
+}
+
+void tst_FingerprintStore::brokenFile()
+{
+    QVERIFY(m_file.parentDir().ensureWritableDir());
+    QVERIFY(m_file.writeFileContents("{ not json"));
+
+    FingerprintStore store(m_file);
+    const QByteArray fingerprint = FingerprintStore::fingerprint({"value"});
+    QVERIFY(!store.contains("project", fingerprint));
+    QVERIFY(store.update("project", fingerprint));
+}
+
+QTEST_GUILESS_MAIN(tst_FingerprintStore)
+
+#include "tst_fingerprintstore.moc"
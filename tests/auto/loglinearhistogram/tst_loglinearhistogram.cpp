@@ -0,0 +1,133 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include <loglinearhistogram.h>
+
+#include <QTest>
+
+using namespace UsageStatistic::Internal;
+
+class tst_LogLinearHistogram : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void bucketIndex_data();
+    void bucketIndex();
+    void bucketBoundsAreMonotonic();
+    void largeValuesAreClamped();
+    void percentile();
+    void emptyHistogram();
+    void buckets();
+    void summary();
+    void clear();
+};
+
+void tst_LogLinearHistogram::bucketIndex_data()
+{
+    QTest::addColumn<qint64>("value");
+
+    for (const qint64 value : {0, 1, 3, 4, 5, 7, 8, 9, 15, 16, 100, 1000, 65535, 1000000})
+        QTest::addRow("%lld", value) << value;
+    QTest::addRow("2^32") << (qint64(1) << 32);
+}
+
+void tst_LogLinearHistogram::bucketIndex()
+{
+    QFETCH(qint64, value);
+
+    const int index = LogLinearHistogram::bucketIndex(value);
+    QVERIFY(index >= 0);
+    QVERIFY(index < LogLinearHistogram::kBuckets);
+    const qint64 upperBound = LogLinearHistogram::bucketUpperBound(index);
+    QVERIFY(upperBound >= value);
+    // the relative error is bounded by the number of sub buckets
+    QVERIFY(upperBound - value <= value / LogLinearHistogram::kSubBuckets);
+    if (index > 0)
+        QVERIFY(LogLinearHistogram::bucketUpperBound(index - 1) < value);
+}
+
+void tst_LogLinearHistogram::bucketBoundsAreMonotonic()
+{
+    for (int i = 1; i < LogLinearHistogram::kBuckets; ++i) {
+        QVERIFY(LogLinearHistogram::bucketUpperBound(i - 1)
+                < LogLinearHistogram::bucketUpperBound(i));
+        QCOMPARE(
+            LogLinearHistogram::bucketIndex(LogLinearHistogram::bucketUpperBound(i)), i);
+    }
+}
+
+void tst_LogLinearHistogram::largeValuesAreClamped()
+{
+    QCOMPARE(LogLinearHistogram::bucketIndex(qint64(1) << 40), LogLinearHistogram::kBuckets - 1);
+    QCOMPARE(LogLinearHistogram::bucketIndex(-5), 0);
+
+    LogLinearHistogram histogram;
+    histogram.add(qint64(1) << 40);
+    QCOMPARE(histogram.max(), qint64(1) << 40);
+    QCOMPARE(histogram.percentile(100), LogLinearHistogram::bucketUpperBound(
+                                            LogLinearHistogram::kBuckets - 1));
+}
+
+void tst_LogLinearHistogram::percentile()
+{
+    LogLinearHistogram histogram;
+    for (qint64 value = 1; value <= 100; ++value)
+        histogram.add(value);
+
+    QCOMPARE(histogram.count(), qint64(100));
+    QCOMPARE(histogram.max(), qint64(100));
+    QCOMPARE(histogram.percentile(50),
+             LogLinearHistogram::bucketUpperBound(LogLinearHistogram::bucketIndex(50)));
+    QCOMPARE(histogram.percentile(90),
+             LogLinearHistogram::bucketUpperBound(LogLinearHistogram::bucketIndex(90)));
+    // never above the largest value that was added
+    QCOMPARE(histogram.percentile(100), qint64(100));
+    QCOMPARE(histogram.percentile(0), qint64(1));
+}
+
+void tst_LogLinearHistogram::emptyHistogram()
+{
+    const LogLinearHistogram histogram;
+    QVERIFY(histogram.isEmpty());
+    QCOMPARE(histogram.percentile(50), qint64(0));
+    QVERIFY(histogram.buckets().isEmpty());
+}
+
+void tst_LogLinearHistogram::buckets()
+{
+    LogLinearHistogram histogram;
+    histogram.add(0);
+    histogram.add(0);
+    histogram.add(5);
+    histogram.add(9);
+    const QVariantMap expected = {{"0", qint64(2)}, {"5", qint64(1)}, {"8", qint64(1)}};
+    QCOMPARE(histogram.buckets(), expected);
+}
+
+void tst_LogLinearHistogram::summary()
+{
+    LogLinearHistogram histogram;
+    histogram.add(3);
+    histogram.add(100);
+    const QVariantMap summary = histogram.summary();
+    QCOMPARE(summary.value("count").toLongLong(), qint64(2));
+    QCOMPARE(summary.value("p50").toLongLong(), qint64(3));
+    QCOMPARE(summary.value("p99").toLongLong(), qint64(100));
+    QCOMPARE(summary.value("max").toLongLong(), qint64(100));
+    QCOMPARE(summary.value("buckets").toMap(), histogram.buckets());
+}
+
+void tst_LogLinearHistogram::clear()
+{
+    LogLinearHistogram histogram;
+    histogram.add(42);
+    histogram.clear();
+    QVERIFY(histogram.isEmpty());
+    QCOMPARE(histogram.max(), qint64(0));
+    QVERIFY(histogram.buckets().isEmpty());
+}
+
+QTEST_GUILESS_MAIN(tst_LogLinearHistogram)
+
+#include "tst_loglinearhistogram.moc"
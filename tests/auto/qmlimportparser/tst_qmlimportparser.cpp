@@ -0,0 +1,135 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include <qmlimportparser.h>
+
+#include <QTemporaryDir>
+#include <QTest>
+
+using namespace UsageStatistic::Internal;
+using namespace Utils;
+
+class tst_QmlImportParser : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void parseImports_data();
+    void parseImports();
+    void parseErrors_data();
+    void parseErrors();
+    void scanImports();
+    void scanSkipsMissingFiles();
+    void scanFailsForBrokenFiles();
+
+private:
+    static FilePath writeFile(
+        const QTemporaryDir &dir, const QString &name, const QByteArray &data);
+};
+
+void tst_QmlImportParser::parseImports_data()
+{
+    QTest::addColumn<QString>("source");
+    QTest::addColumn<QStringList>("modules");
+
+    QTest::newRow("versioned") << "import QtQuick 2.15\nimport QtQuick.Controls 2.15\nItem {}"
+                               << QStringList{"QtQuick", "QtQuick.Controls"};
+    QTest::newRow("unversioned") << "import QtQuick\nItem {}" << QStringList{"QtQuick"};
+    QTest::newRow("qualified") << "import QtQml as Q\nQ.QtObject {}" << QStringList{"QtQml"};
+    QTest::newRow("semicolons") << "import QtQuick; import QtQml; Item {}"
+                                << QStringList{"QtQuick", "QtQml"};
+    QTest::newRow("comments") << "// header\n/* import Fake\n */\nimport QtQuick // trailing\n"
+                                 "/* before */ import QtQml\nItem {}"
+                              << QStringList{"QtQuick", "QtQml"};
+    QTest::newRow("pragma") << "pragma Singleton\npragma ComponentBehavior: Bound\n"
+                               "import QtQuick\nItem {}"
+                            << QStringList{"QtQuick"};
+    QTest::newRow("directory and script imports")
+        << "import \"components\"\nimport 'helpers.js' as Helpers\nimport QtQuick\nItem {}"
+        << QStringList{"QtQuick"};
+    QTest::newRow("byte order mark") << QString(QChar::ByteOrderMark) + "import QtQuick\nItem {}"
+                                     << QStringList{"QtQuick"};
+    QTest::newRow("stops at the object tree")
+        << "import QtQuick\nItem {\n}\nimport Ignored\n" << QStringList{"QtQuick"};
+    QTest::newRow("no imports") << "Item {}" << QStringList();
+    QTest::newRow("empty") << "" << QStringList();
+}
+
+void tst_QmlImportParser::parseImports()
+{
+    QFETCH(QString, source);
+    QFETCH(QStringList, modules);
+
+    const Result<QStringList> imports = parseQmlModuleImports(source);
+    QVERIFY2(imports, qPrintable(imports.error()));
+    QCOMPARE(*imports, modules);
+}
+
+void tst_QmlImportParser::parseErrors_data()
+{
+    QTest::addColumn<QString>("source");
+
+    QTest::newRow("unterminated comment") << "import QtQuick\n/* Item {}";
+    QTest::newRow("unterminated string") << "import \"components\nItem {}";
+    QTest::newRow("end of file in import") << "import ";
+    QTest::newRow("unexpected character") << "import +QtQuick\nItem {}";
+}
+
+void tst_QmlImportParser::parseErrors()
+{
+    QFETCH(QString, source);
+
+    QVERIFY(!parseQmlModuleImports(source));
+}
+
+FilePath tst_QmlImportParser::writeFile(
+    const QTemporaryDir &dir, const QString &name, const QByteArray &data)
+{
+    const FilePath file = FilePath::fromString(dir.filePath(name));
+    if (const Result<> created = file.parentDir().ensureWritableDir(); !created)
+        qWarning() << created.error();
+    if (const Result<qint64> written = file.writeFileContents(data); !written)
+        qWarning() << written.error();
+    return file;
+}
+
+void tst_QmlImportParser::scanImports()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const FilePath main = writeFile(dir, "project/Main.qml", "import QtQuick\nItem {}");
+    const FilePath other = writeFile(dir, "project/Other.qml", "import My.Module\nItem {}");
+    writeFile(dir, "imports/My/Module/qmldir", "module My.Module\nimport QtQml\ndepends QtQuick\n");
+    const FilePath importPath = FilePath::fromString(dir.filePath("imports"));
+
+    const Result<QStringList> modules = scanQmlModuleImports({main, other}, {importPath});
+    QVERIFY2(modules, qPrintable(modules.error()));
+    // sorted, with the dependencies from the qmldir file
+    QCOMPARE(*modules, QStringList({"My.Module", "QtQml", "QtQuick"}));
+}
+
+void tst_QmlImportParser::scanSkipsMissingFiles()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const FilePath main = writeFile(dir, "Main.qml", "import QtQuick\nItem {}");
+    const FilePath removed = FilePath::fromString(dir.filePath("Removed.qml"));
+
+    const Result<QStringList> modules = scanQmlModuleImports({main, removed}, {});
+    QVERIFY2(modules, qPrintable(modules.error()));
+    QCOMPARE(*modules, QStringList({"QtQuick"}));
+}
+
+void tst_QmlImportParser::scanFailsForBrokenFiles()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const FilePath main = writeFile(dir, "Main.qml", "import QtQuick\nItem {}");
+    const FilePath broken = writeFile(dir, "Broken.qml", "import QtQuick\n/* Item {}");
+
+    QVERIFY(!scanQmlModuleImports({main, broken}, {}));
+}
+
+QTEST_GUILESS_MAIN(tst_QmlImportParser)
+
+#include "tst_qmlimportparser.moc"
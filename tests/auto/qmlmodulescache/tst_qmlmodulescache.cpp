@@ -0,0 +1,129 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include <qmlmodulescache.h>
+
+#include <QTemporaryDir>
+#include <QTest>
+
+#include <memory>
+
+using namespace UsageStatistic::Internal;
+using namespace Utils;
+
+class tst_QmlModulesCache : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void init();
+    void storeAndLookup();
+    void fingerprintIgnoresFileOrder();
+    void fingerprintChanges();
+    void missingFiles();
+    void fileInfos();
+    void prune();
+
+private:
+    FilePath writeFile(const QString &name, const QByteArray &data) const;
+
+    std::unique_ptr<QTemporaryDir> m_dir;
+};
+
+void tst_QmlModulesCache::init()
+{
+    m_dir = std::make_unique<QTemporaryDir>();
+    QVERIFY(m_dir->isValid());
+}
+
+FilePath tst_QmlModulesCache::writeFile(const QString &name, const QByteArray &data) const
+{
+    const FilePath file = FilePath::fromString(m_dir->filePath(name));
+    if (const Result<qint64> written = file.writeFileContents(data); !written)
+        qWarning() << written.error();
+    return file;
+}
+
+void tst_QmlModulesCache::storeAndLookup()
+{
+    const QmlModulesCache cache(FilePath::fromString(m_dir->filePath("cache")));
+    const QString fingerprint = QmlModulesCache::fingerprint("scanner", "6.8.0", {}, {});
+
+    QVERIFY(!cache.lookup(fingerprint));
+    const QStringList modules = {"QtQml", "QtQuick", "QtQuick.Controls"};
+    const Result<> stored = cache.store(fingerprint, modules);
+    QVERIFY2(stored, qPrintable(stored.error()));
+    QCOMPARE(cache.lookup(fingerprint).value_or(QStringList()), modules);
+}
+
+void tst_QmlModulesCache::fingerprintIgnoresFileOrder()
+{
+    const FilePath main = writeFile("Main.qml", "import QtQuick\nItem {}");
+    const FilePath other = writeFile("Other.qml", "import QtQml\nQtObject {}");
+
+    QCOMPARE(QmlModulesCache::fingerprint("scanner", "6.8.0", {}, {main, other}),
+             QmlModulesCache::fingerprint("scanner", "6.8.0", {}, {other, main}));
+}
+
+void tst_QmlModulesCache::fingerprintChanges()
+{
+    const FilePath main = writeFile("Main.qml", "import QtQuick\nItem {}");
+    const FilePath importPath = FilePath::fromString(m_dir->filePath("imports"));
+    const QString fingerprint
+        = QmlModulesCache::fingerprint("scanner", "6.8.0", {importPath}, {main});
+
+    QVERIFY(QmlModulesCache::fingerprint("internal", "6.8.0", {importPath}, {main})
+            != fingerprint);
+    QVERIFY(QmlModulesCache::fingerprint("scanner", "6.9.0", {importPath}, {main})
+            != fingerprint);
+    QVERIFY(QmlModulesCache::fingerprint("scanner", "6.8.0", {}, {main}) != fingerprint);
+
+    writeFile("Main.qml", "import QtQuick\nimport QtQuick.Controls\nItem {}");
+    QVERIFY(QmlModulesCache::fingerprint("scanner", "6.8.0", {importPath}, {main})
+            != fingerprint);
+}
+
+void tst_QmlModulesCache::missingFiles()
+{
+    const FilePath main = writeFile("Main.qml", "import QtQuick\nItem {}");
+    const FilePath removed = FilePath::fromString(m_dir->filePath("Removed.qml"));
+    const QString fingerprint
+        = QmlModulesCache::fingerprint("scanner", "6.8.0", {}, {main, removed});
+
+    QCOMPARE(QmlModulesCache::fingerprint("scanner", "6.8.0", {}, {main, removed}), fingerprint);
+    // the file appears
+    writeFile("Removed.qml", "import QtQml\nQtObject {}");
+    QVERIFY(QmlModulesCache::fingerprint("scanner", "6.8.0", {}, {main, removed}) != fingerprint);
+}
+
+void tst_QmlModulesCache::fileInfos()
+{
+    const FilePath main = writeFile("Main.qml", "import QtQuick\nItem {}");
+    const FilePath removed = FilePath::fromString(m_dir->filePath("Removed.qml"));
+
+    const QHash<FilePath, FilePathInfo> infos = QmlModulesCache::fileInfos({main, removed});
+    QCOMPARE(infos.size(), 1);
+    QVERIFY(infos.contains(main));
+    QCOMPARE(infos.value(main).fileSize, main.fileSize());
+    // the fingerprint does not stat the files again when it gets their infos
+    QCOMPARE(QmlModulesCache::fingerprint("scanner", "6.8.0", {}, {main, removed}, infos),
+             QmlModulesCache::fingerprint("scanner", "6.8.0", {}, {main, removed}));
+}
+
+void tst_QmlModulesCache::prune()
+{
+    const FilePath directory = FilePath::fromString(m_dir->filePath("cache"));
+    const QmlModulesCache cache(directory);
+    for (int i = 0; i < 300; ++i) {
+        const QString fingerprint
+            = QmlModulesCache::fingerprint("scanner", QString::number(i), {}, {});
+        QVERIFY(cache.store(fingerprint, {"QtQuick"}));
+    }
+    const qsizetype entries = directory.dirEntries({{}, QDir::Files}).size();
+    QVERIFY(entries > 0);
+    QVERIFY(entries < 300);
+}
+
+QTEST_GUILESS_MAIN(tst_QmlModulesCache)
+
+#include "tst_qmlmodulescache.moc"
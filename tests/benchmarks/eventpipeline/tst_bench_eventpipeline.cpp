@@ -0,0 +1,238 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include <eventpipeline.h>
+#include <fingerprintstore.h>
+#include <loglinearhistogram.h>
+#include <qmlimportparser.h>
+#include <qmlmodulescache.h>
+
+#include <QElapsedTimer>
+#include <QEventLoop>
+#include <QInsightConfiguration>
+#include <QInsightTracker>
+#include <QLoggingCategory>
+#include <QTemporaryDir>
+#include <QTest>
+#include <QTimer>
+
+#include <atomic>
+#include <cstdlib>
+#include <memory>
+#include <new>
+
+// defined by the plugin
+Q_LOGGING_CATEGORY(statLog, "qtc.usagestatistic", QtWarningMsg);
+Q_LOGGING_CATEGORY(benchLog, "qtc.usagestatistic.bench", QtWarningMsg);
+
+using namespace UsageStatistic::Internal;
+using namespace Utils;
+
+// Counts the allocations, to report them per event. This covers the allocations of the
+// benchmark and, where global operators are shared like on Linux, those of the Qt libraries.
+static std::atomic<qint64> s_allocations = 0;
+
+void *operator new(std::size_t size)
+{
+    s_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void *memory = std::malloc(size ? size : 1))
+        return memory;
+    throw std::bad_alloc();
+}
+
+void operator delete(void *memory) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete(void *memory, std::size_t) noexcept
+{
+    std::free(memory);
+}
+
+//! Measures the event pipeline with a real tracker, and the parts of the providers that scale
+//! with the size of the projects, without a running Qt Creator. The providers themselves need
+//! the project tree and kits of ProjectExplorer and are not driven here.
+class tst_BenchEventPipeline : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void pipeline_data();
+    void pipeline();
+    void addEventToTracker();
+    void buildConfigFingerprint();
+    void scanCacheFingerprint_data();
+    void scanCacheFingerprint();
+    void parseImports();
+    void histogram();
+
+private:
+    QTemporaryDir m_dir;
+    std::unique_ptr<QInsightTracker> m_tracker;
+    FilePaths m_qmlFiles;
+};
+
+static const char kQmlHeader[] = "// Copyright header\n"
+                                 "pragma ComponentBehavior: Bound\n"
+                                 "import QtQuick\n"
+                                 "import QtQuick.Controls 2.15\n"
+                                 "import QtQuick.Layouts\n"
+                                 "import \"components\"\n"
+                                 "import 'helpers.js' as Helpers\n"
+                                 "Item {\n    id: root\n}\n";
+
+void tst_BenchEventPipeline::initTestCase()
+{
+    QVERIFY(m_dir.isValid());
+
+    // without a server the tracker only stores the events, like it does between submissions
+    m_tracker = std::make_unique<QInsightTracker>();
+    QInsightConfiguration *config = m_tracker->configuration();
+    config->setEvents({});
+    config->setStoragePath(m_dir.filePath("insight"));
+    config->setSyncInterval(3600);
+    m_tracker->setEnabled(true);
+
+    // 1000 files per directory, like a large project
+    for (int i = 0; i < 100000; ++i) {
+        const FilePath file = FilePath::fromString(
+            m_dir.filePath(QString("qml%1/File%2.qml").arg(i / 1000).arg(i)));
+        if (i % 1000 == 0)
+            QVERIFY(file.parentDir().ensureWritableDir());
+        QVERIFY(file.writeFileContents(kQmlHeader));
+        m_qmlFiles.append(file);
+    }
+}
+
+void tst_BenchEventPipeline::pipeline_data()
+{
+    QTest::addColumn<QByteArray>("encoding");
+    QTest::addColumn<int>("events");
+
+    for (const QByteArray encoding : {"json", "cbor"}) {
+        for (const int events : {1, 100, 10000})
+            QTest::addRow("%s, %d events", encoding.constData(), events) << encoding << events;
+    }
+}
+
+// Pushing the records, serializing them on the worker and adding them to the tracker on the
+// GUI thread. Reports the latency from pushing to delivery, the time spent pushing on the GUI
+// thread and the allocations per event.
+void tst_BenchEventPipeline::pipeline()
+{
+    QFETCH(QByteArray, encoding);
+    QFETCH(int, events);
+
+    qputenv("QTC_USAGESTATISTIC_PAYLOAD_ENCODING", encoding);
+    const QStringList modules = {"QtCore", "QtGui", "QtQml", "QtQuick", "QtQuick.Controls"};
+    LogLinearHistogram latencies; // in microseconds
+    qint64 pushNsecs = 0;
+    qint64 allocations = 0;
+    qint64 pushed = 0;
+    QBENCHMARK {
+        EventPipeline pipeline(m_tracker.get());
+        QEventLoop loop;
+        int delivered = 0;
+        const qint64 allocationsBefore = s_allocations.load();
+        QElapsedTimer timer;
+        timer.start();
+        for (int i = 0; i < events; ++i) {
+            EventRecord record{
+                "Benchmark",
+                {{"projectid", EventRecord::Hashed{QString::number(i % 10)}},
+                 {"qmlmodules", EventRecord::HashedList{modules}},
+                 {"qtversion", QString("6.8.0")},
+                 {"count", qint64(i)}},
+                benchLog};
+            record.onDelivered = [&, pushedNsecs = timer.nsecsElapsed()] {
+                latencies.add((timer.nsecsElapsed() - pushedNsecs) / 1000);
+                if (++delivered == events)
+                    loop.quit();
+            };
+            pipeline.push(std::move(record));
+        }
+        pushNsecs += timer.nsecsElapsed();
+        if (delivered < events) {
+            QTimer::singleShot(10000, &loop, &QEventLoop::quit);
+            loop.exec();
+        }
+        allocations += s_allocations.load() - allocationsBefore;
+        pushed += events;
+        QCOMPARE(delivered, events);
+    }
+    qunsetenv("QTC_USAGESTATISTIC_PAYLOAD_ENCODING");
+
+    const QVariantMap latency = latencies.summary();
+    qInfo().noquote() << QString("latency p50 %1 us p99 %2 us, push %3 ns, %4 allocations "
+                                 "per event")
+                             .arg(latency.value("p50").toLongLong())
+                             .arg(latency.value("p99").toLongLong())
+                             .arg(pushNsecs / pushed)
+                             .arg(double(allocations) / pushed, 0, 'f', 1);
+}
+
+// The time the delivery of each event takes on the GUI thread.
+void tst_BenchEventPipeline::addEventToTracker()
+{
+    const QString data = R"({"projectid":"4b227777d4dd1fc61c6f884f48641d02","count":1})";
+    QBENCHMARK {
+        addEvent(m_tracker.get(), "Benchmark", data);
+    }
+}
+
+// The fingerprint of a build configuration, as computed after every parse.
+void tst_BenchEventPipeline::buildConfigFingerprint()
+{
+    QStringList packages;
+    for (int i = 0; i < 60; ++i)
+        packages.append(QString("Qt6Module%1").arg(i));
+    const QString qtPackages = packages.join(',');
+    QBENCHMARK {
+        FingerprintStore::fingerprint(
+            {qtPackages, "6.8.0", "CMake", "Desktop", "Desktop", "GCC", "13.2.0", "GDB", "14.2"});
+    }
+}
+
+void tst_BenchEventPipeline::scanCacheFingerprint_data()
+{
+    QTest::addColumn<int>("files");
+
+    for (const int files : {10, 1000, 10000, 100000})
+        QTest::addRow("%d files", files) << files;
+}
+
+// Looking up whether a QML module scan can be skipped, which stats every file.
+void tst_BenchEventPipeline::scanCacheFingerprint()
+{
+    QFETCH(int, files);
+
+    const FilePaths qmlFiles = m_qmlFiles.mid(0, files);
+    QBENCHMARK {
+        QmlModulesCache::fingerprint("qmlimportscanner", "6.8.0", {}, qmlFiles);
+    }
+}
+
+void tst_BenchEventPipeline::parseImports()
+{
+    const QString source = QString::fromUtf8(kQmlHeader);
+    QBENCHMARK {
+        QVERIFY(parseQmlModuleImports(source));
+    }
+}
+
+void tst_BenchEventPipeline::histogram()
+{
+    LogLinearHistogram histogram;
+    qint64 value = 0;
+    QBENCHMARK {
+        histogram.add(value);
+        value = (value * 31 + 7) % 100000;
+    }
+    QVERIFY(!histogram.isEmpty());
+}
+
+QTEST_GUILESS_MAIN(tst_BenchEventPipeline)
+
+#include "tst_bench_eventpipeline.moc"
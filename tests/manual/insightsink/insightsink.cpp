@@ -0,0 +1,117 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include "insightsink.h"
+
+#include <QPointer>
+#include <QTcpSocket>
+#include <QTimer>
+
+namespace UsageStatistic::Internal {
+
+InsightSink::InsightSink(std::chrono::milliseconds responseDelay)
+    : m_responseDelay(responseDelay)
+{
+    connect(this, &QTcpServer::newConnection, this, &InsightSink::acceptConnections);
+}
+
+bool InsightSink::start()
+{
+    if (!listen(QHostAddress::LocalHost))
+        return false;
+    m_sinceListening.start();
+    return true;
+}
+
+QUrl InsightSink::url() const
+{
+    QUrl url;
+    url.setScheme("http");
+    url.setHost(serverAddress().toString());
+    url.setPort(serverPort());
+    return url;
+}
+
+qint64 InsightSink::payloadBytes() const
+{
+    qint64 bytes = 0;
+    for (const Request &request : m_requests)
+        bytes += request.payloadSize;
+    return bytes;
+}
+
+qint64 InsightSink::msecsSinceLastRequest() const
+{
+    const qint64 last = m_requests.isEmpty() ? 0 : m_requests.last().receivedMsecs;
+    return m_sinceListening.elapsed() - last;
+}
+
+void InsightSink::acceptConnections()
+{
+    while (QTcpSocket *socket = nextPendingConnection()) {
+        m_connections.insert(socket, {});
+        connect(socket, &QTcpSocket::readyRead, this, [this, socket] { readRequests(socket); });
+        connect(socket, &QTcpSocket::disconnected, this, [this, socket] {
+            m_connections.remove(socket);
+            socket->deleteLater();
+        });
+    }
+}
+
+void InsightSink::readRequests(QTcpSocket *socket)
+{
+    Connection &connection = m_connections[socket];
+    if (connection.buffer.isEmpty())
+        connection.sinceFirstByte.start();
+    connection.buffer += socket->readAll();
+
+    // keep-alive connections can carry several requests one after the other
+    while (true) {
+        const qsizetype headerEnd = connection.buffer.indexOf("\r\n\r\n");
+        if (headerEnd < 0)
+            return;
+        const QList<QByteArray> lines = connection.buffer.left(headerEnd).split('\n');
+        const QList<QByteArray> requestLine = lines.first().trimmed().split(' ');
+        qint64 contentLength = 0;
+        for (const QByteArray &line : lines.mid(1)) {
+            const qsizetype colon = line.indexOf(':');
+            if (colon <= 0)
+                continue;
+            if (line.left(colon).trimmed().compare("content-length", Qt::CaseInsensitive) == 0)
+                contentLength = line.mid(colon + 1).trimmed().toLongLong();
+        }
+        const qsizetype requestSize = headerEnd + 4 + contentLength;
+        if (connection.buffer.size() < requestSize)
+            return;
+
+        Request request;
+        request.method = requestLine.value(0);
+        request.path = requestLine.value(1);
+        request.payloadSize = contentLength;
+        respond(socket, request, connection.sinceFirstByte);
+
+        connection.buffer.remove(0, requestSize);
+        if (!connection.buffer.isEmpty())
+            connection.sinceFirstByte.start();
+    }
+}
+
+void InsightSink::respond(QTcpSocket *socket, Request request, const QElapsedTimer &sinceFirstByte)
+{
+    const auto send =
+        [this, socket = QPointer<QTcpSocket>(socket), request, sinceFirstByte]() mutable {
+        if (!socket)
+            return;
+        socket->write("HTTP/1.1 200 OK\r\nContent-Length: 0\r\nConnection: keep-alive\r\n\r\n");
+        request.latencyMsecs = sinceFirstByte.elapsed();
+        request.receivedMsecs = m_sinceListening.elapsed();
+        m_requests.append(request);
+        emit requestReceived();
+    };
+    if (m_responseDelay.count() > 0)
+        QTimer::singleShot(m_responseDelay, this, send);
+    else
+        send();
+}
+
+} // namespace UsageStatistic::Internal
@@ -0,0 +1,66 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#pragma once
+
+#include <QElapsedTimer>
+#include <QHash>
+#include <QList>
+#include <QTcpServer>
+#include <QUrl>
+
+#include <chrono>
+
+QT_BEGIN_NAMESPACE
+class QTcpSocket;
+QT_END_NAMESPACE
+
+namespace UsageStatistic::Internal {
+
+//! Stands in for the Qt Insight backend on a local port. Every HTTP request is recorded and
+//! answered with an empty "200 OK", optionally after a delay that simulates the round trip to
+//! a real server. Only bodies with a Content-Length are supported, which is what
+//! QNetworkAccessManager sends for the uploads of QInsightTracker.
+class InsightSink : public QTcpServer
+{
+    Q_OBJECT
+public:
+    struct Request
+    {
+        QByteArray method;
+        QByteArray path;
+        qint64 payloadSize = 0;
+        qint64 latencyMsecs = 0; // from the first byte of the request until the response is sent
+        qint64 receivedMsecs = 0; // since the sink started listening
+    };
+
+    explicit InsightSink(std::chrono::milliseconds responseDelay = {});
+
+    bool start(); // listens on 127.0.0.1, at any free port
+    QUrl url() const;
+
+    const QList<Request> &requests() const { return m_requests; }
+    qint64 payloadBytes() const;
+    qint64 msecsSinceLastRequest() const;
+
+signals:
+    void requestReceived();
+
+private:
+    struct Connection
+    {
+        QByteArray buffer;
+        QElapsedTimer sinceFirstByte;
+    };
+
+    void acceptConnections();
+    void readRequests(QTcpSocket *socket);
+    void respond(QTcpSocket *socket, Request request, const QElapsedTimer &sinceFirstByte);
+
+    QHash<QTcpSocket *, Connection> m_connections;
+    QList<Request> m_requests;
+    QElapsedTimer m_sinceListening;
+    std::chrono::milliseconds m_responseDelay;
+};
+
+} // namespace UsageStatistic::Internal
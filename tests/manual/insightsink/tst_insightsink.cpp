@@ -0,0 +1,137 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include "insightsink.h"
+
+#include <eventpipeline.h>
+
+#include <QDirIterator>
+#include <QElapsedTimer>
+#include <QInsightConfiguration>
+#include <QInsightTracker>
+#include <QLoggingCategory>
+#include <QTemporaryDir>
+#include <QTest>
+
+#include <algorithm>
+
+// defined by the plugin
+Q_LOGGING_CATEGORY(statLog, "qtc.usagestatistic", QtWarningMsg);
+
+using namespace std::chrono;
+using namespace UsageStatistic::Internal;
+
+//! Pushes events through a real QInsightTracker to a local InsightSink and reports the number,
+//! size and latency of the uploads and the data kept on disk in between, per batch size.
+//! QTC_INSIGHT_BATCHSIZE selects a single batch size, QTC_INSIGHT_SUBMISSIONINTERVAL the
+//! seconds between submissions (default 1), QTC_USAGESTATISTIC_LOAD_EVENTS the number of
+//! events (default 2000) and QTC_USAGESTATISTIC_SINK_DELAY_MS the response delay of the sink.
+class tst_InsightSink : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void throughput_data();
+    void throughput();
+};
+
+static int fromEnvironment(const char *key, int defaultValue)
+{
+    bool ok = false;
+    const int value = qEnvironmentVariableIntValue(key, &ok);
+    return ok ? value : defaultValue;
+}
+
+static qint64 storageUsage(const QString &path)
+{
+    qint64 bytes = 0;
+    QDirIterator it(path, QDir::Files | QDir::Hidden, QDirIterator::Subdirectories);
+    while (it.hasNext())
+        bytes += it.nextFileInfo().size();
+    return bytes;
+}
+
+static qint64 median(QList<qint64> values)
+{
+    if (values.isEmpty())
+        return 0;
+    const auto middle = values.begin() + values.size() / 2;
+    std::nth_element(values.begin(), middle, values.end());
+    return *middle;
+}
+
+void tst_InsightSink::throughput_data()
+{
+    QTest::addColumn<int>("batchSize");
+
+    const int batchSize = fromEnvironment("QTC_INSIGHT_BATCHSIZE", 0);
+    if (batchSize > 0) {
+        QTest::addRow("batch %d", batchSize) << batchSize;
+        return;
+    }
+    for (const int size : {1, 10, 100, 1000})
+        QTest::addRow("batch %d", size) << size;
+}
+
+void tst_InsightSink::throughput()
+{
+    QFETCH(int, batchSize);
+    const int syncInterval = std::max(1, fromEnvironment("QTC_INSIGHT_SUBMISSIONINTERVAL", 1));
+    const int eventCount = fromEnvironment("QTC_USAGESTATISTIC_LOAD_EVENTS", 2000);
+
+    InsightSink sink(milliseconds(fromEnvironment("QTC_USAGESTATISTIC_SINK_DELAY_MS", 0)));
+    QVERIFY(sink.start());
+    QTemporaryDir storage;
+    QVERIFY(storage.isValid());
+
+    QInsightTracker tracker;
+    QInsightConfiguration *config = tracker.configuration();
+    config->setEvents({});
+    config->setStoragePath(storage.path());
+    config->setServer(sink.url().toString());
+    config->setToken("insightsink");
+    config->setBatchSize(batchSize);
+    config->setSyncInterval(syncInterval);
+    tracker.setEnabled(true);
+
+    // the disk usage is largest right before an upload is answered
+    qint64 maxStorage = 0;
+    connect(&sink, &InsightSink::requestReceived, this, [&] {
+        maxStorage = std::max(maxStorage, storageUsage(storage.path()));
+    });
+
+    QElapsedTimer timer;
+    timer.start();
+    for (int i = 0; i < eventCount; ++i)
+        addEvent(&tracker, "InsightSink", QString("Event %1").arg(i));
+    const qint64 addNsecs = timer.nsecsElapsed();
+    maxStorage = std::max(maxStorage, storageUsage(storage.path()));
+
+    // the tracker uploads on its own schedule, the run is over once the sink is idle for two
+    // submission intervals
+    QTRY_VERIFY_WITH_TIMEOUT(!sink.requests().isEmpty(), 10 * syncInterval * 1000);
+    const qint64 idleMsecs = 2 * syncInterval * 1000;
+    while (sink.msecsSinceLastRequest() < idleMsecs)
+        QTest::qWait(100);
+
+    QList<qint64> latencies;
+    for (const InsightSink::Request &request : sink.requests())
+        latencies.append(request.latencyMsecs);
+    const qsizetype requests = sink.requests().size();
+    qInfo().noquote() << QString("batch size %1, %2 events: %3 requests, %4 payload bytes "
+                                 "(%5 per request), latency median %6 ms max %7 ms, "
+                                 "addEvent %8 us per event, at most %9 bytes on disk")
+                             .arg(batchSize)
+                             .arg(eventCount)
+                             .arg(requests)
+                             .arg(sink.payloadBytes())
+                             .arg(sink.payloadBytes() / requests)
+                             .arg(median(latencies))
+                             .arg(*std::max_element(latencies.cbegin(), latencies.cend()))
+                             .arg(double(addNsecs) / 1000 / std::max(1, eventCount), 0, 'f', 2)
+                             .arg(maxStorage);
+}
+
+QTEST_GUILESS_MAIN(tst_InsightSink)
+
+#include "tst_insightsink.moc"